@@ -0,0 +1,271 @@
+//Microbenchmarks of the core hot paths on synthetic inputs drawn from a fixed seed.  Every benchmark
+//runs until it has taken at least --min-time seconds and reports the time per call.  The results go
+//to stdout (or --json FILE) as JSON so that runs of different versions can be compared.
+//
+//    dodona_bench [--filter SUBSTRING] [--min-time SECONDS] [--seed N] [--json FILE]
+
+#include "FitnessFunctions.h"
+#include "InputModels/Interpolation.h"
+#include "InputModels/SimpleGaussianModel.h"
+#include "InputModels/SimpleInterpolationModel.h"
+#include "Keyboard.h"
+#include "Polygon.h"
+#include "RadixTree.h"
+#include "WordList.h"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef DODONA_BUILD_TYPE
+#define DODONA_BUILD_TYPE "unknown"
+#endif
+
+using namespace std;
+
+namespace {
+    //a benchmark returns a checksum of what it computed.  The first call's is reported, so versions can
+    //be checked for the same answers, and the rest go to a sink so none of the work is optimized away.
+    class Benchmark {
+      public:
+        string name;
+        function<double()> run;
+        Benchmark(const string& n, function<double()> r) : name(n), run(r) {}
+    };
+
+    class Measurement {
+      public:
+        string name;
+        unsigned long calls;
+        double seconds, checksum;
+    };
+
+    Measurement Measure(const Benchmark& b, double min_time) {
+        typedef chrono::steady_clock clock;
+        Measurement m;
+        m.name = b.name;
+        m.checksum = b.run();
+        volatile double sink = 0;
+        //double the batch until one takes long enough to time
+        for(unsigned long batch = 1; ; batch *= 2) {
+            const clock::time_point start = clock::now();
+            for(unsigned long i = 0; i < batch; i++) {
+                sink = sink + b.run();
+            }
+            m.seconds = chrono::duration<double>(clock::now() - start).count();
+            m.calls = batch;
+            if(m.seconds >= min_time) break;
+        }
+        return m;
+    }
+
+    Polygon Rectangle(double x, double y, double width, double height) {
+        Polygon p;
+        p.AddVertex(x, y);
+        p.AddVertex(x + width, y);
+        p.AddVertex(x + width, y + height);
+        p.AddVertex(x, y + height);
+        return p;
+    }
+
+    //a qwerty-like layout of unit keys
+    Keyboard SyntheticKeyboard() {
+        const char *rows[3] = {"qwertyuiop", "asdfghjkl", "zxcvbnm."};
+        Keyboard k;
+        for(unsigned int r = 0; r < 3; r++) {
+            for(unsigned int i = 0; i < strlen(rows[r]); i++) {
+                k.AddKey(rows[r][i], Rectangle(i + 0.5*r, -double(r), 1, 1));
+            }
+        }
+        return k;
+    }
+
+    //random lowercase words with 1/rank occurances
+    WordList SyntheticWordList(unsigned int words, boost::mt19937& generator) {
+        boost::random::uniform_int_distribution<> letter(0, 25), length(2, 8);
+        WordList w;
+        for(unsigned int rank = 1; w.Words() < words; rank++) {
+            string word(length(generator), 'a');
+            for(unsigned int i = 0; i < word.size(); i++) word[i] = 'a' + letter(generator);
+            w.AddWord(word.c_str(), max(1u, 100000/rank));
+        }
+        w.Prepare();
+        return w;
+    }
+
+    string JsonString(const string& s) {
+        string out = "\"";
+        for(unsigned int i = 0; i < s.size(); i++) {
+            if(s[i] == '"' || s[i] == '\\') out += '\\';
+            out += s[i];
+        }
+        return out + "\"";
+    }
+};
+
+int main(int argc, char** argv) {
+    string filter, json;
+    double min_time = 0.2;
+    unsigned int seed = 0;
+    for(int a = 1; a < argc; a++) {
+        const string arg = argv[a];
+        if(arg == "--filter" && a + 1 < argc) filter = argv[++a];
+        else if(arg == "--min-time" && a + 1 < argc) min_time = atof(argv[++a]);
+        else if(arg == "--seed" && a + 1 < argc) seed = atoi(argv[++a]);
+        else if(arg == "--json" && a + 1 < argc) json = argv[++a];
+        else {
+            cerr << "usage: " << argv[0] << " [--filter SUBSTRING] [--min-time SECONDS] [--seed N] [--json FILE]" << endl;
+            return 1;
+        }
+    }
+
+    //every input is drawn here, up front, from the one seed
+    boost::mt19937 generator(seed);
+    Keyboard keyboard = SyntheticKeyboard();
+    WordList words = SyntheticWordList(2000, generator);
+    WordList small_words = SyntheticWordList(200, generator);
+
+    boost::random::uniform_real_distribution<> x(-1, 11), y(-2.5, 1.5);
+    vector< pair<double, double> > points(1024);
+    for(unsigned int i = 0; i < points.size(); i++) points[i] = make_pair(x(generator), y(generator));
+    Polygon polygon = keyboard.GetKey('g');
+
+    string characters;
+    for(unsigned int i = 0; i < 1024; i++) characters += keyboard.CharN(generator() % keyboard.NKeys());
+
+    vector<string> sample_words(256);
+    for(unsigned int i = 0; i < sample_words.size(); i++) sample_words[i] = words.Word(generator() % words.Words());
+
+    SimpleGaussianModel sgm(0.5, 0.5);
+    sgm.SetSeed(seed);
+    SimpleInterpolationModel sim(50, 0.5, 0.5);
+    sim.SetSeed(seed);
+
+    vector<InputVector> sgm_vectors(sample_words.size()), sim_vectors(sample_words.size()), perfect(sample_words.size());
+    vector<string> stringforms(sample_words.size());
+    for(unsigned int i = 0; i < sample_words.size(); i++) {
+        sgm_vectors[i] = sgm.RandomVector(sample_words[i].c_str(), keyboard);
+        sim_vectors[i] = sim.RandomVector(sample_words[i].c_str(), keyboard);
+        perfect[i] = sgm.PerfectVector(sample_words[i].c_str(), keyboard);
+        const char *stringform = sgm_vectors[i].StringForm(keyboard);
+        stringforms[i] = stringform;
+        delete [] stringform;
+    }
+
+    unsigned int cursor = 0;
+    vector<Benchmark> benchmarks;
+    benchmarks.push_back(Benchmark("Polygon::IsInside", [&]() {
+        double inside = 0;
+        for(unsigned int i = 0; i < points.size(); i++) inside += polygon.IsInside(points[i].first, points[i].second);
+        return inside;
+    }));
+    benchmarks.push_back(Benchmark("Keyboard::GetKey", [&]() {
+        double sum = 0;
+        for(unsigned int i = 0; i < characters.size(); i++) sum += keyboard.GetKey(characters[i]).VertexX(0);
+        return sum;
+    }));
+
+    //into one output vector, so once it has grown nothing is allocated
+    typedef void (*interpolation)(InputVector&, unsigned int, InputVector&);
+    InputVector interpolated;
+    const char *interpolation_names[7] = {"SpatialInterpolation", "HermiteCubicSplineInterpolation",
+        "MonotonicCubicSplineInterpolation", "CubicSplineInterpolation", "ModCubicSplineInterpolation",
+        "BezierInterpolation", "BezierSloppyInterpolation"};
+    const interpolation interpolations[7] = {&SpatialInterpolation, &HermiteCubicSplineInterpolation,
+        &MonotonicCubicSplineInterpolation, &CubicSplineInterpolation, &ModCubicSplineInterpolation,
+        &BezierInterpolation, &BezierSloppyInterpolation};
+    for(unsigned int f = 0; f < 7; f++) {
+        const interpolation function = interpolations[f];
+        benchmarks.push_back(Benchmark(interpolation_names[f], [&, function]() {
+            function(perfect[cursor++ % perfect.size()], 50, interpolated);
+            return interpolated.Length() > 0 ? interpolated.X(interpolated.Length() - 1) : 0;
+        }));
+    }
+
+    benchmarks.push_back(Benchmark("SimpleGaussianModel::RandomVector", [&]() {
+        return sgm.RandomVector(sample_words[cursor++ % sample_words.size()].c_str(), keyboard).X(0);
+    }));
+    benchmarks.push_back(Benchmark("SimpleGaussianModel::Distance", [&]() {
+        const unsigned int i = cursor++ % sample_words.size();
+        return sgm.Distance(sgm_vectors[i], sample_words[(i + 1) % sample_words.size()].c_str(), keyboard);
+    }));
+    benchmarks.push_back(Benchmark("SimpleInterpolationModel::RandomVector", [&]() {
+        return sim.RandomVector(sample_words[cursor++ % sample_words.size()].c_str(), keyboard).X(0);
+    }));
+    benchmarks.push_back(Benchmark("SimpleInterpolationModel::Distance", [&]() {
+        const unsigned int i = cursor++ % sample_words.size();
+        return sim.Distance(sim_vectors[i], sample_words[(i + 1) % sample_words.size()].c_str(), keyboard);
+    }));
+    benchmarks.push_back(Benchmark("SimpleGaussianModel::BestMatch", [&]() {
+        return (double) strlen(sgm.BestMatch(sgm_vectors[cursor++ % sgm_vectors.size()], keyboard, words));
+    }));
+    benchmarks.push_back(Benchmark("SimpleInterpolationModel::BestMatch", [&]() {
+        return (double) strlen(sim.BestMatch(sim_vectors[cursor++ % sim_vectors.size()], keyboard, words));
+    }));
+    RadixTree *tree = words.GetTree();
+    benchmarks.push_back(Benchmark("RadixTree::Matches", [&]() {
+        return (double) tree->Matches(stringforms[cursor++ % stringforms.size()].c_str()).size();
+    }));
+    benchmarks.push_back(Benchmark("WordList::RandomWord", [&]() {
+        double sum = 0;
+        for(unsigned int i = 0; i < 1024; i++) sum += words.RandomWord()[0];
+        return sum;
+    }));
+    benchmarks.push_back(Benchmark("FitnessFunctions::MonteCarloEfficiency", [&]() {
+        return FitnessFunctions::MonteCarloEfficiency(keyboard, sgm, small_words, 100).Fitness();
+    }));
+    benchmarks.push_back(Benchmark("FitnessFunctions::FastEfficiency", [&]() {
+        return FitnessFunctions::FastEfficiency(keyboard, sim, small_words, 1.0).Fitness();
+    }));
+    benchmarks.push_back(Benchmark("FitnessFunctions::TruncatedFastEfficiency", [&]() {
+        return FitnessFunctions::TruncatedFastEfficiency(keyboard, sim, small_words, 1.0, 1e-6).Fitness();
+    }));
+    benchmarks.push_back(Benchmark("FitnessFunctions::RadixMonteCarloEfficiency", [&]() {
+        return FitnessFunctions::RadixMonteCarloEfficiency(keyboard, sgm, small_words, 100, 10).Fitness();
+    }));
+
+    ostringstream out;
+    out.precision(10);
+    out << "{\n  \"version\": 1,\n  \"build_type\": " << JsonString(DODONA_BUILD_TYPE) << ",\n  \"seed\": " << seed
+        << ",\n  \"min_time\": " << min_time << ",\n  \"benchmarks\": [";
+    bool first = true;
+    for(unsigned int b = 0; b < benchmarks.size(); b++) {
+        if(benchmarks[b].name.find(filter) == string::npos) continue;
+        //so that the reported checksum doesn't depend on which benchmarks ran before
+        cursor = 0;
+        sgm.SetSeed(seed);
+        sim.SetSeed(seed);
+        words.SetSeed(seed);
+        small_words.SetSeed(seed);
+        const Measurement m = Measure(benchmarks[b], min_time);
+        cerr << m.name << ": " << 1e9*m.seconds/m.calls << " ns" << endl;
+        out << (first ? "\n" : ",\n") << "    {\"name\": " << JsonString(m.name) << ", \"calls\": " << m.calls
+            << ", \"seconds\": " << m.seconds << ", \"ns_per_call\": " << 1e9*m.seconds/m.calls
+            << ", \"checksum\": " << m.checksum << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+
+    if(json.empty()) {
+        cout << out.str();
+    }
+    else {
+        ofstream file(json.c_str());
+        file << out.str();
+        if(!file.good()) {
+            cerr << "ERROR: Unable to write " << json << "." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
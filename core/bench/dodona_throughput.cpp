@@ -0,0 +1,213 @@
+//End to end throughput of EvaluateKeyboards, the number clusters are sized by.  The population is the
+//standard, Dvorak, hexagonal and T9 keyboards with their characters shuffled, evaluated against
+//Zipfian word lists for every combination of fitness function, input model, word list size and thread
+//count.  Each combination reports keyboards per second and BestMatch calls per second, where a
+//MonteCarlo iteration counts as one call and a RadixMonteCarlo iteration as one per possibility try.
+//FastEfficiency makes no BestMatch calls, so it reports the distances between pairs of perfect vectors
+//it takes per second instead, N^2 per keyboard for N words.  It is skipped for fixed length models and
+//for lists longer than --fast-max-words.
+//
+//    dodona_throughput [--words 1000,10000,100000] [--threads 1,N] [--fitness MonteCarlo,Fast,RadixMonteCarlo]
+//                      [--models SimpleGaussianModel,SimpleInterpolationModel] [--batch N] [--iterations N]
+//                      [--fast-max-words N] [--block N] [--min-time SECONDS] [--seed N] [--json FILE]
+//
+//--block sets EvaluationOptions::block, the samples per scheduled task.
+
+#include "EvaluationOptions.h"
+#include "FitnessFunctions.h"
+#include "InputModels/SimpleGaussianModel.h"
+#include "InputModels/SimpleInterpolationModel.h"
+#include "Keyboard.h"
+#include "StandardKeyboards.h"
+#include "WordList.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdlib.h>
+
+#ifndef DODONA_BUILD_TYPE
+#define DODONA_BUILD_TYPE "unknown"
+#endif
+
+using namespace std;
+
+namespace {
+    vector<string> Split(const string& s) {
+        vector<string> parts;
+        istringstream in(s);
+        string part;
+        while(getline(in, part, ',')) {
+            if(!part.empty()) parts.push_back(part);
+        }
+        return parts;
+    }
+
+    vector<unsigned int> SplitNumbers(const string& s) {
+        const vector<string> parts = Split(s);
+        vector<unsigned int> numbers;
+        for(unsigned int i = 0; i < parts.size(); i++) numbers.push_back(atoi(parts[i].c_str()));
+        return numbers;
+    }
+
+    string JsonString(const string& s) {
+        string out = "\"";
+        for(unsigned int i = 0; i < s.size(); i++) {
+            if(s[i] == '"' || s[i] == '\\') out += '\\';
+            out += s[i];
+        }
+        return out + "\"";
+    }
+
+    bool ParseEfficiency(const string& name, EvaluationOptions::Efficiency& efficiency) {
+        if(name == "MonteCarlo") efficiency = EvaluationOptions::MonteCarlo;
+        else if(name == "Fast") efficiency = EvaluationOptions::Fast;
+        else if(name == "RadixMonteCarlo") efficiency = EvaluationOptions::RadixMonteCarlo;
+        else return false;
+        return true;
+    }
+};
+
+int main(int argc, char** argv) {
+    const unsigned int cores = max(thread::hardware_concurrency(), 1u);
+    vector<unsigned int> word_counts, thread_counts;
+    word_counts.push_back(1000);
+    word_counts.push_back(10000);
+    word_counts.push_back(100000);
+    thread_counts.push_back(1);
+    if(cores > 1) thread_counts.push_back(cores);
+    vector<string> fitnesses = Split("MonteCarlo,Fast,RadixMonteCarlo");
+    vector<string> models = Split("SimpleGaussianModel,SimpleInterpolationModel");
+    //FastEfficiency is quadratic in the number of words so the largest lists are left to the others
+    unsigned int batch = 1, iterations = 10, possibility_tries = 10, fast_max_words = 1000, block = 0, seed = 0;
+    double min_time = 0;
+    string json;
+    for(int a = 1; a < argc; a++) {
+        const string arg = argv[a];
+        if(arg == "--words" && a + 1 < argc) word_counts = SplitNumbers(argv[++a]);
+        else if(arg == "--threads" && a + 1 < argc) thread_counts = SplitNumbers(argv[++a]);
+        else if(arg == "--fitness" && a + 1 < argc) fitnesses = Split(argv[++a]);
+        else if(arg == "--models" && a + 1 < argc) models = Split(argv[++a]);
+        else if(arg == "--batch" && a + 1 < argc) batch = atoi(argv[++a]);
+        else if(arg == "--iterations" && a + 1 < argc) iterations = atoi(argv[++a]);
+        else if(arg == "--fast-max-words" && a + 1 < argc) fast_max_words = atoi(argv[++a]);
+        else if(arg == "--block" && a + 1 < argc) block = atoi(argv[++a]);
+        else if(arg == "--min-time" && a + 1 < argc) min_time = atof(argv[++a]);
+        else if(arg == "--seed" && a + 1 < argc) seed = atoi(argv[++a]);
+        else if(arg == "--json" && a + 1 < argc) json = argv[++a];
+        else {
+            cerr << "usage: " << argv[0] << " [--words 1000,10000,100000] [--threads 1,N]"
+                 << " [--fitness MonteCarlo,Fast,RadixMonteCarlo] [--models SimpleGaussianModel,SimpleInterpolationModel]"
+                 << " [--batch N] [--iterations N] [--fast-max-words N] [--block N] [--min-time SECONDS] [--seed N] [--json FILE]" << endl;
+            return 1;
+        }
+    }
+    for(unsigned int f = 0; f < fitnesses.size(); f++) {
+        EvaluationOptions::Efficiency efficiency;
+        if(!ParseEfficiency(fitnesses[f], efficiency)) {
+            cerr << "ERROR: Unknown fitness function " << fitnesses[f] << "." << endl;
+            return 1;
+        }
+    }
+    for(unsigned int m = 0; m < models.size(); m++) {
+        if(models[m] != "SimpleGaussianModel" && models[m] != "SimpleInterpolationModel") {
+            cerr << "ERROR: Unknown input model " << models[m] << "." << endl;
+            return 1;
+        }
+    }
+
+    //batch shuffles of each geometry, the same for every combination
+    const Keyboard geometries[4] = {StandardKeyboards::Qwerty(), StandardKeyboards::Dvorak(),
+        StandardKeyboards::Hexagonal(), StandardKeyboards::T9()};
+    vector<Keyboard> keyboards;
+    for(unsigned int g = 0; g < 4; g++) {
+        for(unsigned int b = 0; b < batch; b++) {
+            Keyboard k(geometries[g]);
+            k.SetSeed(seed + keyboards.size());
+            k.Randomize();
+            keyboards.push_back(k);
+        }
+    }
+
+    SimpleGaussianModel sgm(0.5, 0.5);
+    SimpleInterpolationModel sim(50, 0.5, 0.5);
+
+    ostringstream out;
+    out.precision(10);
+    out << "{\n  \"version\": 1,\n  \"build_type\": " << JsonString(DODONA_BUILD_TYPE) << ",\n  \"seed\": " << seed
+        << ",\n  \"hardware_concurrency\": " << cores << ",\n  \"keyboards\": " << keyboards.size()
+        << ",\n  \"iterations\": " << iterations << ",\n  \"block\": " << block << ",\n  \"results\": [";
+    bool first = true;
+    for(unsigned int w = 0; w < word_counts.size(); w++) {
+        WordList words = WordList::Zipfian(word_counts[w], 1.0, seed);
+        for(unsigned int f = 0; f < fitnesses.size(); f++) {
+            EvaluationOptions options;
+            ParseEfficiency(fitnesses[f], options.efficiency);
+            if(options.efficiency == EvaluationOptions::Fast && words.Words() > fast_max_words) continue;
+            options.iterations = iterations;
+            options.possibility_tries = possibility_tries;
+            options.seed = seed;
+            options.block = block;
+            //a radix iteration decodes each of its possibility_tries vectors, while Fast's work is its
+            //pairwise distances
+            const bool fast = options.efficiency == EvaluationOptions::Fast;
+            unsigned long work = keyboards.size()*(unsigned long) iterations;
+            if(fast) work = keyboards.size()*(unsigned long) words.Words()*words.Words();
+            if(options.efficiency == EvaluationOptions::RadixMonteCarlo) work *= possibility_tries;
+            const char *work_name = fast ? "pairwise_distances_per_second" : "best_match_calls_per_second";
+            const char *work_unit = fast ? " distances/s" : " BestMatch/s";
+
+            for(unsigned int m = 0; m < models.size(); m++) {
+                InputModel& model = models[m] == "SimpleGaussianModel" ? (InputModel&) sgm : (InputModel&) sim;
+                //FastEfficiency compares the perfect vectors of every pair of words, which only models
+                //whose vectors don't depend on the word length can do
+                if(options.efficiency == EvaluationOptions::Fast && model.FixedLength()) continue;
+                for(unsigned int t = 0; t < thread_counts.size(); t++) {
+                    options.threads = thread_counts[t];
+                    typedef chrono::steady_clock clock;
+                    const clock::time_point start = clock::now();
+                    unsigned int runs = 0;
+                    double seconds = 0, fitness = 0;
+                    //at least one run, repeated until min_time has passed
+                    do {
+                        vector<FitnessResult> results = FitnessFunctions::EvaluateKeyboards(keyboards, model, words, options);
+                        fitness = 0;
+                        for(unsigned int r = 0; r < results.size(); r++) fitness += results[r].Fitness()/results.size();
+                        runs++;
+                        seconds = chrono::duration<double>(clock::now() - start).count();
+                    } while(seconds < min_time);
+
+                    const double keyboards_per_second = runs*keyboards.size()/seconds;
+                    const double work_per_second = runs*work/seconds;
+                    cerr << fitnesses[f] << " " << models[m] << " " << words.Words() << " words " << thread_counts[t]
+                         << " threads: " << keyboards_per_second << " keyboards/s, " << work_per_second << work_unit << endl;
+                    out << (first ? "\n" : ",\n") << "    {\"fitness\": " << JsonString(fitnesses[f])
+                        << ", \"model\": " << JsonString(models[m]) << ", \"words\": " << words.Words()
+                        << ", \"threads\": " << thread_counts[t] << ", \"runs\": " << runs << ", \"seconds\": " << seconds
+                        << ", \"keyboards_per_second\": " << keyboards_per_second
+                        << ", \"" << work_name << "\": " << work_per_second
+                        << ", \"mean_fitness\": " << fitness << "}";
+                    first = false;
+                }
+            }
+        }
+    }
+    out << "\n  ]\n}\n";
+
+    if(json.empty()) {
+        cout << out.str();
+    }
+    else {
+        ofstream file(json.c_str());
+        file << out.str();
+        if(!file.good()) {
+            cerr << "ERROR: Unable to write " << json << "." << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef ArrayView_py_h
+#define ArrayView_py_h
+
+#include <boost/python/class.hpp>
+#include <boost/python/object.hpp>
+#include <boost/python/extract.hpp>
+
+#include <map>
+#include <vector>
+#include <string.h>
+
+using namespace boost::python;
+
+//Exposes an array (of doubles unless given another format) owned by another python object through
+//the buffer protocol, so that memoryview and numpy.asarray read and write it in place.  The view
+//keeps the owner alive, and the owner's methods that could reallocate the array raise BufferError
+//through CheckNoArrayViews for as long as any view of it is held.
+class ArrayView {
+  public:
+    object owner;
+    //the C++ object holding the array, which its exports are counted against
+    const void *key;
+    void *data;
+    const char *format;
+    Py_ssize_t itemsize;
+    bool readonly;
+    std::vector<Py_ssize_t> shape, strides;
+};
+
+//the buffers currently exported from each C++ object's arrays
+std::map<const void*, unsigned int>& ArrayViewExports() {
+    static std::map<const void*, unsigned int> exports;
+    return exports;
+}
+
+//for the python methods that resize key's arrays
+void CheckNoArrayViews(const void* key) {
+    if(ArrayViewExports().count(key) > 0) {
+        PyErr_SetString(PyExc_BufferError, "The arrays can't be resized while views of them exist.");
+        throw_error_already_set();
+    }
+}
+
+int ArrayViewGetBuffer(PyObject* exporter, Py_buffer* view, int flags) {
+    ArrayView& a = extract<ArrayView&>(exporter);
+    //empty arrays still need a valid pointer
+    static double empty = 0;
+
+    Py_ssize_t items = 1;
+    for(unsigned int i = 0; i < a.shape.size(); i++) items *= a.shape[i];
+
+    if(a.readonly && (flags & PyBUF_WRITABLE)) {
+        PyErr_SetString(PyExc_BufferError, "This array is read only.");
+        view->obj = 0;
+        return -1;
+    }
+
+    view->obj = exporter;
+    Py_INCREF(exporter);
+    view->buf = a.data ? a.data : &empty;
+    view->len = items*a.itemsize;
+    view->readonly = a.readonly;
+    view->itemsize = a.itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? (char*) a.format : 0;
+    view->ndim = a.shape.size();
+    view->shape = (flags & PyBUF_ND) ? &a.shape[0] : 0;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &a.strides[0] : 0;
+    view->suboffsets = 0;
+    view->internal = 0;
+    ArrayViewExports()[a.key]++;
+    return 0;
+}
+
+void ArrayViewReleaseBuffer(PyObject* exporter, Py_buffer* view) {
+    ArrayView& a = extract<ArrayView&>(exporter);
+    std::map<const void*, unsigned int>::iterator it = ArrayViewExports().find(a.key);
+    if(it != ArrayViewExports().end() && --it->second == 0) {
+        ArrayViewExports().erase(it);
+    }
+}
+
+void RegisterArrayView() {
+    static PyBufferProcs procs = { &ArrayViewGetBuffer, &ArrayViewReleaseBuffer };
+    object type = class_<ArrayView>("ArrayView", no_init);
+    ((PyTypeObject*) type.ptr())->tp_as_buffer = &procs;
+}
+
+//a memoryview of the C-contiguous array at data with the given shape, whose items have the struct
+//module format code format.  key is the C++ object the array belongs to.
+object MakeArrayView(object owner, const void* key, void* data, const char* format, Py_ssize_t itemsize,
+        std::vector<Py_ssize_t> shape, bool readonly = false) {
+    ArrayView a;
+    a.owner = owner;
+    a.key = key;
+    a.data = data;
+    a.format = format;
+    a.itemsize = itemsize;
+    a.readonly = readonly;
+    a.shape = shape;
+    a.strides.resize(shape.size());
+    Py_ssize_t stride = itemsize;
+    for(int i = int(shape.size()) - 1; i >= 0; i--) {
+        a.strides[i] = stride;
+        stride *= shape[i];
+    }
+    object exporter(a);
+    return object(handle<>(PyMemoryView_FromObject(exporter.ptr())));
+}
+
+object MakeArrayView(object owner, const void* key, double* data, std::vector<Py_ssize_t> shape) {
+    return MakeArrayView(owner, key, data, "d", sizeof(double), shape);
+}
+
+//copies a buffer of doubles into values, returning false with a python error set if o isn't one
+bool ReadDoubleBuffer(object o, std::vector<double>& values) {
+    Py_buffer view;
+    if(PyObject_GetBuffer(o.ptr(), &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        return false;
+    }
+    const bool doubles = view.itemsize == sizeof(double) && view.format && strlen(view.format) > 0 && view.format[strlen(view.format)-1] == 'd';
+    if(doubles) {
+        const double *data = (const double*) view.buf;
+        values.assign(data, data + view.len/sizeof(double));
+    }
+    PyBuffer_Release(&view);
+    if(!doubles) {
+        PyErr_SetString(PyExc_TypeError, "Expected a contiguous buffer of float64 values.");
+    }
+    return doubles;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef ConfusionMatrix_h
+#define ConfusionMatrix_h
+
+#include "FitnessResult.h"
+
+#include <stdint.h>
+#include <vector>
+
+//One cell of a ConfusionMatrix: target was decoded as decoded count times out of samples
+class Confusion {
+  public:
+    unsigned int target, decoded, count, samples;
+    //count/samples and its standard error, and the same weighted by the target's share of the list's
+    //occurrences, which is the chance a word typed from the list is the target and decoded this way
+    double rate, rate_error, share, share_error;
+
+    Confusion();
+};
+
+//How often each word was decoded as each word of the list, as a compressed sparse row matrix.  Row t
+//holds word t of the list: columns[offsets[t]] to columns[offsets[t+1]] are the words it was decoded as,
+//in increasing order, and counts how many times.  Decodings that didn't land on a word of the list
+//aren't kept, so a row's counts can add up to less than its samples.
+class ConfusionMatrix {
+    unsigned int words;
+    std::vector<uint32_t> offsets, columns, counts, samples;
+    //each target's share of the list's occurrences
+    std::vector<double> weights;
+  public:
+    explicit ConfusionMatrix(unsigned int words = 0);
+
+    //appends the next target's row, with columns in increasing order
+    void AddRow(unsigned int samples, double weight, const std::vector<uint32_t>& columns, const std::vector<uint32_t>& counts);
+
+    unsigned int Words() const { return words; }
+    unsigned int Targets() const { return samples.size(); }
+    unsigned int Entries() const { return columns.size(); }
+    unsigned int Samples(unsigned int target) const;
+    double Weight(unsigned int target) const;
+    unsigned int Count(unsigned int target, unsigned int decoded) const;
+    Confusion Entry(unsigned int target, unsigned int decoded) const;
+
+    //the n confusions of one word for another with the largest shares, largest first
+    std::vector<Confusion> TopConfusions(unsigned int n) const;
+    //the share of the targets' occurrences that were decoded correctly, the MonteCarloEfficiency of
+    //the targets with the samples stratified by word
+    FitnessResult Efficiency() const;
+
+    const uint32_t* OffsetData() const { return offsets.size() > 0 ? &offsets[0] : 0; }
+    const uint32_t* ColumnData() const { return columns.size() > 0 ? &columns[0] : 0; }
+    const uint32_t* CountData() const { return counts.size() > 0 ? &counts[0] : 0; }
+    const uint32_t* SampleData() const { return samples.size() > 0 ? &samples[0] : 0; }
+    const double* WeightData() const { return weights.size() > 0 ? &weights[0] : 0; }
+};
+
+#endif
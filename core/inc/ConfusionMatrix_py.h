@@ -0,0 +1,41 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef ConfusionMatrix_py_h
+#define ConfusionMatrix_py_h
+
+#include "ConfusionMatrix.h"
+#include "FitnessFunctions.h"
+#include "ArrayView_py.h"
+
+#include <vector>
+
+#include <boost/python/dict.hpp>
+#include <boost/python/list.hpp>
+#include <boost/python/overloads.hpp>
+
+using namespace boost::python;
+
+BOOST_PYTHON_FUNCTION_OVERLOADS(Confusions_overloads, FitnessFunctions::Confusions, 4, 7)
+
+list ConfusionMatrixTopConfusions(ConfusionMatrix& m, unsigned int n) {
+    const std::vector<Confusion> confusions = m.TopConfusions(n);
+    list l;
+    for(unsigned int i = 0; i < confusions.size(); i++) {
+        l.append(confusions[i]);
+    }
+    return l;
+}
+
+//read only views of the CSR arrays, for scipy.sparse.csr_matrix((counts, columns, offsets))
+dict ConfusionMatrixArrays(object self) {
+    ConfusionMatrix& m = extract<ConfusionMatrix&>(self);
+    const std::vector<Py_ssize_t> rows(1, m.Targets()), offsets(1, m.Targets() + 1), entries(1, m.Entries());
+    dict arrays;
+    arrays["offsets"] = MakeArrayView(self, &m, (void*) m.OffsetData(), "I", sizeof(uint32_t), offsets, true);
+    arrays["columns"] = MakeArrayView(self, &m, (void*) m.ColumnData(), "I", sizeof(uint32_t), entries, true);
+    arrays["counts"] = MakeArrayView(self, &m, (void*) m.CountData(), "I", sizeof(uint32_t), entries, true);
+    arrays["samples"] = MakeArrayView(self, &m, (void*) m.SampleData(), "I", sizeof(uint32_t), rows, true);
+    arrays["weights"] = MakeArrayView(self, &m, (void*) m.WeightData(), "d", sizeof(double), rows, true);
+    return arrays;
+}
+
+#endif
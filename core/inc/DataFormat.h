@@ -11,6 +11,8 @@
 #include "boost/serialization/vector.hpp"
 #include "boost/serialization/string.hpp"
 #include "boost/serialization/utility.hpp"
+#include <boost/unordered_map.hpp>
+#include <stdint.h>
 
 
 namespace boost {namespace serialization {class access;}}
@@ -30,6 +32,10 @@ class DataFormat {
     //Each result2 will be stored as a pair containing the specific keyboard and a vector of
     //pairs of the efficiency string (i.e. "MC", "fast", etc) and the fitness result2s (efficiency)
     std::vector<resultEntry> result_vector;
+    //entry indices by keyboard hash so AddEntry doesn't have to compare against every keyboard
+    boost::unordered_multimap<uint64_t, unsigned int> layout_index;
+    void RebuildIndex();
+    int FindEntry(Keyboard& k);
 
   public: 
     DataFormat();
@@ -55,11 +61,19 @@ class DataFormat {
     std::string GetDistanceMeasureName() const { return distance_measure; }
     void SetDistanceMeasureName(std::string dmName) { distance_measure = dmName; }
 
+    //the word list's own state, the names and every entry, with the keyboards' and results' states, in
+    //the fixed little-endian layout of PackedState.h
+    std::string PackState();
+    //returns false and leaves the results as they were if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
 
   private:
     friend class boost::serialization::access;
     template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
         ar & w & word_list  & input_model & distance_measure & result_vector;
+        if(Archive::is_loading::value) {
+            RebuildIndex();
+        }
     }
 };
 
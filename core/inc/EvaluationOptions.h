@@ -0,0 +1,34 @@
+#ifndef EvaluationOptions_h
+#define EvaluationOptions_h
+
+#include "PerfectVectorStore.h"
+
+//Which fitness function EvaluateKeyboards should run and with what parameters
+class EvaluationOptions {
+  public:
+    enum Efficiency { MonteCarlo, Fast, RadixMonteCarlo };
+
+    Efficiency efficiency;
+    unsigned int iterations;
+    unsigned int possibility_tries;
+    double exp_par;
+    //the precision FastEfficiency compares perfect vectors at, unless epsilon is set
+    PerfectVectorStore::Precision precision;
+    //above 0, FastEfficiency is only computed to within epsilon (see TruncatedFastEfficiency) and
+    //reports a bound on what it left out as the results' Truncation().  This takes precedence over
+    //precision: the truncated version always compares at full precision.
+    double epsilon;
+    //0 uses every available core
+    unsigned int threads;
+    //keyboard i is evaluated with everything seeded to seed + i, independently of the thread count
+    unsigned int seed;
+    //the samples per task when a keyboard's MonteCarlo or RadixMonteCarlo estimate is split between
+    //threads, 0 for one task per keyboard.  Blocks after the first are seeded from the keyboard's seed
+    //and their index, so a block size gives the same results on any number of threads.
+    unsigned int block;
+
+    EvaluationOptions() : efficiency(MonteCarlo), iterations(1000), possibility_tries(10), exp_par(1.0), precision(PerfectVectorStore::Double), epsilon(0),
+        threads(0), seed(0), block(0) {}
+};
+
+#endif
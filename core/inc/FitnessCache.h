@@ -0,0 +1,52 @@
+#ifndef FitnessCache_h
+#define FitnessCache_h
+
+#include "EvaluationOptions.h"
+#include "FitnessResult.h"
+#include "InputModels/InputModel.h"
+#include "Keyboard.h"
+#include "WordList.h"
+
+#include <boost/unordered_map.hpp>
+
+#include <list>
+#include <mutex>
+#include <utility>
+#include <stdint.h>
+
+//A thread-safe, bounded memo of fitness results keyed by layout hash and a context fingerprint (the word
+//list, input model and fitness function that produced them).  When full the least recently used entry
+//is evicted.  Monte Carlo results added under an existing key are combined with FitnessResult::operator+
+//so repeated evaluations of the same layout keep refining one estimate.
+class FitnessCache {
+    typedef std::list< std::pair<uint64_t, FitnessResult> > entrylist;
+    typedef boost::unordered_map<uint64_t, entrylist::iterator> entrymap;
+
+    entrylist entries;
+    entrymap index;
+    unsigned int capacity;
+    unsigned int hits, misses;
+    std::mutex lock;
+
+    FitnessCache(const FitnessCache&);
+    FitnessCache& operator=(const FitnessCache&);
+  public:
+    FitnessCache(unsigned int capacity = 100000);
+
+    //the new samples must be independent of the cached ones for the combination to be meaningful
+    FitnessResult Add(uint64_t key, FitnessResult result);
+    bool Lookup(uint64_t key, FitnessResult& result);
+
+    unsigned int Size();
+    unsigned int Capacity() { return capacity; }
+    void SetCapacity(unsigned int c);
+    unsigned int Hits() { return hits; }
+    unsigned int Misses() { return misses; }
+    void Clear();
+
+    static uint64_t Key(Keyboard& keyboard, uint64_t context);
+    //options.threads and options.seed don't change what is being estimated so they're left out
+    static uint64_t Context(WordList& words, const InputModel& model, EvaluationOptions& options);
+};
+
+#endif
@@ -1,15 +1,66 @@
 #ifndef FitnessFunctions_h
 #define FitnessFunctions_h
 
+#include "ConfusionMatrix.h"
+#include "EvaluationOptions.h"
 #include "FitnessResult.h"
+#include "FrozenWordList.h"
+#include "ImportanceProposal.h"
 #include "InputModels/InputModel.h"
 #include "Keyboard.h"
+#include "PerfectVectorStore.h"
+#include "SampleSet.h"
 #include "WordList.h"
 
+#include <vector>
+#include <stdint.h>
+
+class FitnessCache;
+
 namespace FitnessFunctions {
     FitnessResult MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations);
+    FitnessResult MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, SampleSet& samples);
+    FitnessResult MonteCarloEfficiencyDifference(Keyboard& keyboard1, Keyboard& keyboard2, InputModel& model, WordList& words, SampleSet& samples);
+    FitnessResult StratifiedMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, unsigned int bands);
+    FitnessResult LengthStratifiedMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations);
+    //builds an ImportanceProposal for this one call, pass one in to share it between calls on the same keyboard
+    FitnessResult ImportanceMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, double exp_par);
+    FitnessResult ImportanceMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, const ImportanceProposal& proposal);
     FitnessResult FastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par);
+    //models with a euclidean VectorDistance compare the perfect vectors through a PerfectVectorStore at
+    //this precision, anything else falls back to the full precision version
+    FitnessResult FastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par, PerfectVectorStore::Precision precision);
+    //FastEfficiency to within epsilon, leaving out the pairs whose exp(-exp_par*distance) is below
+    //epsilon/(number of words), found through a PerfectVectorIndex.  The result's Truncation() is a bound
+    //on what they leave out: the exact result is between fitness - truncation and fitness.  Models
+    //without a euclidean VectorDistance get the exact version.
+    FitnessResult TruncatedFastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par, double epsilon);
     FitnessResult RadixMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, unsigned int possibility_tries);
+    //the same with the words drawn from word_generator and the noise from noise_generator, leaving the
+    //list's and the model's own generators alone
+    FitnessResult MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations,
+            boost::mt19937& word_generator, boost::mt19937& noise_generator);
+    FitnessResult RadixMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations,
+            unsigned int possibility_tries, boost::mt19937& word_generator, boost::mt19937& noise_generator);
+
+    //the same over a snapshot that several threads can share, with a model they can share too if it's
+    //Shareable().  The words are drawn from word_generator and the noise from noise_generator, and
+    //seeded as the list and the model would be they give exactly the results the versions above do.
+    FitnessResult MonteCarloEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, unsigned int iterations,
+            boost::mt19937& word_generator, boost::mt19937& noise_generator);
+    FitnessResult FastEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, double exp_par);
+    FitnessResult FastEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, double exp_par, PerfectVectorStore::Precision precision);
+    FitnessResult TruncatedFastEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, double exp_par, double epsilon);
+    FitnessResult RadixMonteCarloEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, unsigned int iterations,
+            unsigned int possibility_tries, boost::mt19937& word_generator, boost::mt19937& noise_generator);
+
+    //decodes samples noisy vectors of each of the first targets words of the list (0 for all of them) on
+    //threads threads (0 for every core) and counts what each was decoded as
+    ConfusionMatrix Confusions(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int samples, unsigned int targets = 0,
+            unsigned int threads = 0, unsigned int seed = 0);
+
+    std::vector<FitnessResult> EvaluateKeyboards(std::vector<Keyboard>& keyboards, InputModel& model, WordList& words, EvaluationOptions& options,
+            FitnessCache* cache = 0, uint64_t context = 0);
 };
 
 #endif
@@ -0,0 +1,56 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef FitnessFunctions_py_h
+#define FitnessFunctions_py_h
+
+#include "FitnessFunctions.h"
+#include "FitnessCache.h"
+
+#include <vector>
+
+#include <boost/python/list.hpp>
+#include <boost/python/extract.hpp>
+
+using namespace boost::python;
+
+FitnessResult (*MonteCarloEfficiency1)(Keyboard&, InputModel&, WordList&, unsigned int) = &FitnessFunctions::MonteCarloEfficiency;
+FitnessResult (*MonteCarloEfficiency2)(Keyboard&, InputModel&, WordList&, SampleSet&) = &FitnessFunctions::MonteCarloEfficiency;
+FitnessResult (*ImportanceMonteCarloEfficiency1)(Keyboard&, InputModel&, WordList&, unsigned int, double) = &FitnessFunctions::ImportanceMonteCarloEfficiency;
+FitnessResult (*ImportanceMonteCarloEfficiency2)(Keyboard&, InputModel&, WordList&, unsigned int, const ImportanceProposal&) = &FitnessFunctions::ImportanceMonteCarloEfficiency;
+FitnessResult (*FastEfficiency1)(Keyboard&, InputModel&, WordList&, double) = &FitnessFunctions::FastEfficiency;
+FitnessResult (*FastEfficiency2)(Keyboard&, InputModel&, WordList&, double, PerfectVectorStore::Precision) = &FitnessFunctions::FastEfficiency;
+FitnessResult (*TruncatedFastEfficiency1)(Keyboard&, InputModel&, WordList&, double, double) = &FitnessFunctions::TruncatedFastEfficiency;
+FitnessResult (*RadixMonteCarloEfficiency1)(Keyboard&, InputModel&, WordList&, unsigned int, unsigned int) = &FitnessFunctions::RadixMonteCarloEfficiency;
+
+list EvaluateCachedKeyboardList(list keyboards, InputModel& model, WordList& words, EvaluationOptions& options, FitnessCache* cache, uint64_t context) {
+    std::vector<Keyboard> kvector;
+    for(unsigned int i = 0; i < len(keyboards); i++) {
+        kvector.push_back(extract<Keyboard&>(keyboards[i]));
+    }
+    std::vector<FitnessResult> results = FitnessFunctions::EvaluateKeyboards(kvector, model, words, options, cache, context);
+
+    list l;
+    for(unsigned int i = 0; i < results.size(); i++) {
+        l.append(results[i]);
+    }
+    return l;
+}
+
+list EvaluateKeyboardList(list keyboards, InputModel& model, WordList& words, EvaluationOptions& options) {
+    return EvaluateCachedKeyboardList(keyboards, model, words, options, 0, 0);
+}
+
+/***************** FitnessCache helpers *****************/
+object FitnessCacheLookup(FitnessCache& cache, Keyboard& k, uint64_t context) {
+    FitnessResult result;
+    if(cache.Lookup(FitnessCache::Key(k, context), result)) {
+        return object(result);
+    }
+    return object();
+}
+
+FitnessResult FitnessCacheAdd(FitnessCache& cache, Keyboard& k, uint64_t context, FitnessResult result) {
+    return cache.Add(FitnessCache::Key(k, context), result);
+}
+/********************************************************/
+
+#endif
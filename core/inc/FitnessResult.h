@@ -1,12 +1,22 @@
 #ifndef FitnessResult_h
 #define FitnessResult_h
 
+#include "Instrumentation.h"
+
+#include "boost/serialization/version.hpp"
+
+#include <string>
+
 namespace boost {namespace serialization {class access;}}
 
 class FitnessResult {
   protected:
     unsigned int iterations;
     double fitness, error;
+    double truncation;
+#ifdef DODONA_INSTRUMENTATION
+    Instrumentation::Stats stats;
+#endif
   public:
     FitnessResult();
     FitnessResult(unsigned int iterations, double fitness, double error);
@@ -20,11 +30,31 @@ class FitnessResult {
     void SetError(double e) { error = e; }
     void SetIterations(unsigned int i) { iterations = i; }
 
+    //how far the fitness can be above the exact value because of terms the fitness function left out,
+    //see TruncatedFastEfficiency.  Unlike the error it isn't statistical: the exact value is between
+    //fitness - truncation and fitness.
+    double Truncation() { return truncation; }
+    void SetTruncation(double t) { truncation = t; }
+
+    //what the evaluation counted, empty unless the library is built with instrumentation.  It isn't
+    //serialized.
+    Instrumentation::Stats GetStats() const;
+    void SetStats(const Instrumentation::Stats& s);
+
+    //everything but the stats in the fixed little-endian layout of PackedState.h
+    std::string PackState() const;
+    //returns false and leaves the result as it was if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
+
   private:
     friend class boost::serialization::access;
     template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
         ar & iterations & fitness & error;
+        if(version > 0) ar & truncation;
+        else truncation = 0;
     }
 };
 
+BOOST_CLASS_VERSION(FitnessResult, 1)
+
 #endif
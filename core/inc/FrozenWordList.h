@@ -0,0 +1,56 @@
+#ifndef FrozenWordList_h
+#define FrozenWordList_h
+
+#include <boost/noncopyable.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/discrete_distribution.hpp>
+
+#include "RadixTree.h"
+#include "WordList.h"
+
+#include <string>
+#include <stdint.h>
+#include <vector>
+
+//An immutable snapshot of a WordList, with the sorted words, the distribution and the radix tree all
+//built when it's made.  Nothing reads through a cache or a generator of its own, so any number of
+//threads can share one; RandomWord draws from the caller's generator instead.  Words are indexed just
+//as in the list it was taken from, and a generator seeded like the list's draws the same words.
+class FrozenWordList : private boost::noncopyable {
+    //the words nul separated, most common first, and where each one starts
+    std::string text;
+    std::vector<uint32_t> offsets;
+    std::vector<unsigned int> occurance_vector;
+    //the indices of the words of each length, and of every word in alphabetical order
+    std::vector<unsigned int> Nindex_vector[MAXN];
+    std::vector<unsigned int> alphabetical;
+
+    boost::random::discrete_distribution<> distribution;
+    RadixTree tree;
+    unsigned int letters[128];
+    unsigned int total_letters, total;
+    uint64_t fingerprint;
+
+  public:
+    explicit FrozenWordList(WordList& words);
+
+    unsigned int Words() const { return occurance_vector.size(); }
+    const char* Word(const unsigned int index) const { return text.c_str() + offsets[index]; }
+    unsigned int Occurances(const unsigned int index) const { return occurance_vector[index]; }
+    unsigned int Occurances(const char *word) const;
+    unsigned int TotalOccurances() const { return total; }
+    unsigned int NWords(const unsigned int N) const;
+    const char* NWord(const unsigned int N, const unsigned int index) const;
+    unsigned int NOccurances(const unsigned int N, const unsigned int index) const;
+    unsigned int MaxN() const { return MAXN; }
+    int WordIndex(const char* word) const;
+    const char* RandomWord(boost::mt19937& generator) const { return Word(distribution(generator)); }
+
+    unsigned int TotalLetterOccurances() const { return total_letters; }
+    unsigned int LetterOccurances(const char c) const;
+    //the same as the WordList's
+    uint64_t Fingerprint() const { return fingerprint; }
+    const RadixTree* GetTree() const { return &tree; }
+};
+
+#endif
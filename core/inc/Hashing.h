@@ -0,0 +1,47 @@
+#ifndef Hashing_h
+#define Hashing_h
+
+#include <stdint.h>
+#include <string.h>
+
+//Small 64-bit hashing helpers shared by the layout hashes and the fitness cache.  These have to give
+//the same values on every platform and run since hashes end up in files and pickles.
+
+//the splitmix64 finalizer
+inline uint64_t HashMix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t HashCombine(uint64_t seed, uint64_t value) {
+    return HashMix(seed ^ HashMix(value));
+}
+
+inline uint64_t HashDouble(double d) {
+    if(d == 0) d = 0; //so that -0.0 hashes like 0.0
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return HashMix(bits);
+}
+
+//FNV-1a
+inline uint64_t HashString(const char* s) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for(; *s; s++) {
+        h = (h ^ (unsigned char) *s)*0x100000001b3ULL;
+    }
+    return h;
+}
+
+//FNV-1a over raw bytes
+inline uint64_t HashBytes(const char* data, size_t n) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < n; i++) {
+        h = (h ^ (unsigned char) data[i])*0x100000001b3ULL;
+    }
+    return h;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef ImportanceProposal_h
+#define ImportanceProposal_h
+
+#include "InputModels/InputModel.h"
+#include "Keyboard.h"
+#include "WordList.h"
+
+#include <stdint.h>
+#include <vector>
+
+//Each word's estimated chance of being confused on one keyboard, which ImportanceMonteCarloEfficiency
+//draws its samples in proportion to.  A word's estimate is 1 - the product of FastEfficiency's pairwise
+//terms, 1 - exp(-exp_par*d)/2, over the other words it could be decoded as: every word but itself, or
+//for a fixed length model the other words of its length.  Building it is most of the cost of an
+//evaluation, so keep it for as long as the keyboard and the list don't change.
+class ImportanceProposal {
+    std::vector<double> confusion;
+    double mean_confusion;
+    uint64_t keyboard_hash, list_fingerprint;
+  public:
+    ImportanceProposal();
+    ImportanceProposal(Keyboard& keyboard, const InputModel& model, WordList& words, double exp_par);
+    //models with a euclidean VectorDistance only compare the pairs whose terms are within 1e-6 of 1,
+    //found through a PerfectVectorIndex; the estimates only steer the sampling so that's plenty
+    void Build(Keyboard& keyboard, const InputModel& model, WordList& words, double exp_par);
+
+    unsigned int Words() const { return confusion.size(); }
+    double Confusion(unsigned int i) const { return confusion[i]; }
+    //weighted by the words' occurances
+    double MeanConfusion() const { return mean_confusion; }
+    uint64_t KeyboardHash() const { return keyboard_hash; }
+    uint64_t ListFingerprint() const { return list_fingerprint; }
+};
+
+#endif
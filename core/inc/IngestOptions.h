@@ -0,0 +1,60 @@
+#ifndef IngestOptions_h
+#define IngestOptions_h
+
+#include <string>
+
+//How WordList::IngestFiles splits and cleans text.  Tokens are separated by ascii whitespace, like
+//python's str.split(), and the defaults match wordlists.AlphaOnly for ascii text: letters are
+//lowercased and everything else dropped.  Non-ascii bytes are never letters, so utf-8 text keeps
+//accented letters only with alpha_only off.
+class IngestOptions {
+  public:
+    //drop every character that isn't an ascii letter or in keep
+    bool alpha_only;
+    bool lowercase;
+    std::string keep;
+    //cleaned tokens shorter than this are skipped
+    unsigned int min_length;
+    //0 uses every available core
+    unsigned int threads;
+
+    IngestOptions() : alpha_only(true), lowercase(true), min_length(1), threads(0) {}
+};
+
+//Splits text into tokens cleaned according to a set of IngestOptions
+class TokenCleaner {
+    bool keep[256];
+    bool lowercase;
+    unsigned int min_length;
+
+  public:
+    TokenCleaner(const IngestOptions& options) : lowercase(options.lowercase), min_length(options.min_length) {
+        for(unsigned int c = 0; c < 256; c++) {
+            const bool letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            keep[c] = !options.alpha_only || letter || options.keep.find((char) c) != std::string::npos;
+        }
+    }
+
+    //the separators of python's str.split() below 128
+    static bool IsSeparator(unsigned char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r') || (c >= 0x1c && c <= 0x1f);
+    }
+
+    //reads the next token at or after p into token, skipping any that clean down to nothing or to
+    //fewer than min_length characters.  False at the end of the text.
+    bool Next(const char*& p, const char* end, std::string& token) const {
+        while(p < end) {
+            while(p < end && IsSeparator(*p)) p++;
+            token.clear();
+            for(; p < end && !IsSeparator(*p); p++) {
+                const unsigned char c = *p;
+                if(!keep[c]) continue;
+                token += (char) (lowercase && c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            }
+            if(token.size() > 0 && token.size() >= min_length) return true;
+        }
+        return false;
+    }
+};
+
+#endif
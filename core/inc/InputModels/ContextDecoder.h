@@ -0,0 +1,65 @@
+#ifndef ContextDecoder_h
+#define ContextDecoder_h
+
+#include "InputModels/InputModel.h"
+#include "InputModels/InputVector.h"
+#include "Keyboard.h"
+#include "NGramModel.h"
+#include "WordList.h"
+
+#include <string>
+#include <vector>
+
+//How often a decoder recovered the intended words, with and without context
+class DecodingReport {
+  public:
+    unsigned int words, correct, baseline_correct;
+
+    DecodingReport() : words(0), correct(0), baseline_correct(0) {}
+    double Accuracy() const { return words > 0 ? double(correct)/double(words) : 0; }
+    double BaselineAccuracy() const { return words > 0 ? double(baseline_correct)/double(words) : 0; }
+};
+
+//Picks words by combining an input model's Distance with an n-gram prior.  For each input vector the
+//list is first pruned (for path models to the words whose keys its StringForm passes through, as
+//RadixMonteCarloEfficiency does) and only the beam of those with the smallest distances are kept as
+//candidates.  Each is scored
+//    distance_weight*Distance - lm_weight*log P(word | previous words)
+//with the lowest score winning.  With lm_weight 0 and a large enough beam BestMatch agrees with
+//InputModel::BestMatch whenever the closest word survives the pruning.
+class ContextDecoder {
+  public:
+    double distance_weight, lm_weight;
+    unsigned int beam;
+
+    ContextDecoder() : distance_weight(1.0), lm_weight(0.1), beam(16) {}
+
+    //the best word for vector following the words of context
+    const char* BestMatch(const InputModel& model, InputVector& vector, Keyboard& k, WordList& w, NGramModel& lm,
+            const std::vector<std::string>& context);
+    //the best sequence of words for a sequence of vectors, searching over the beam best partial
+    //sequences at each step so that later words can change the choice of earlier ones.  A vector with no
+    //candidates at all decodes to an empty string without affecting the rest.
+    std::vector<std::string> Decode(const InputModel& model, std::vector<InputVector>& vectors, Keyboard& k, WordList& w,
+            NGramModel& lm);
+    //draws a random vector for every word of text that is in the word list from a generator seeded with
+    //seed, leaving the model's own alone, then decodes them all with Decode and one at a time with the
+    //model's own BestMatch
+    DecodingReport Accuracy(const InputModel& model, Keyboard& k, WordList& w, NGramModel& lm,
+            const std::vector<std::string>& text, unsigned int seed = 0);
+
+  private:
+    class Candidate {
+      public:
+        const char *word;
+        double distance;
+        uint32_t id;
+    };
+    //the beam closest of the words the radix tree matches to a path's StringForm, closest first and
+    //alphabetically on ties.  For taps, or when nothing matches (e.g. the path starts off the keyboard),
+    //the words InputModel::BestMatch compares are searched instead, in list order.
+    void Candidates(const InputModel& model, InputVector& vector, Keyboard& k, WordList& w, NGramModel& lm,
+            std::vector<Candidate>& candidates);
+};
+
+#endif
@@ -3,10 +3,14 @@
 
 #include <boost/random/mersenne_twister.hpp>
 
+#include <stdint.h>
+
 #include "InputModels/InputVector.h"
 #include "Keyboard.h"
 #include "WordList.h"
 
+class FrozenWordList;
+
 class InputModel {
   protected:
     boost::mt19937 generator;
@@ -14,14 +18,40 @@ class InputModel {
 
   public:
     InputModel() { fixed_length = false; }
-    bool FixedLength() { return fixed_length; }
+    bool FixedLength() const { return fixed_length; }
 
-    virtual InputVector RandomVector(const char* word, Keyboard& k) = 0;
-    virtual InputVector PerfectVector(const char* word, Keyboard& k) = 0;
-    virtual double Distance(InputVector& vector, const char* word, Keyboard& k) = 0;
-    virtual double VectorDistance(InputVector& vector1, InputVector& vector2) = 0;
+    //draws the noise from generator.  Everything const leaves the model alone, so models that are
+    //Shareable() can serve any number of threads at once, each with its own generator.
+    virtual InputVector RandomVector(const char* word, Keyboard& k, boost::mt19937& generator) const = 0;
+    //the same drawing from the model's own generator, which SetSeed seeds
+    InputVector RandomVector(const char* word, Keyboard& k) { return RandomVector(word, k, generator); }
+    virtual InputVector PerfectVector(const char* word, Keyboard& k) const = 0;
+    //builds the vector RandomVector would return if its standard normal draws were `offsets`
+    //(two per letter, x then y).  Models that can't replay noise print an error and throw
+    //std::runtime_error rather than quietly losing the common random numbers.
+    virtual InputVector OffsetVector(const char* word, Keyboard& k, const double* offsets) const;
+    virtual double Distance(InputVector& vector, const char* word, Keyboard& k) const = 0;
+    virtual double VectorDistance(InputVector& vector1, InputVector& vector2) const = 0;
+    //distances[i] = VectorDistance(vector, vectors[i]) for i < n; models with a faster batched form override it
+    virtual void VectorDistanceBatch(InputVector& vector, InputVector* vectors, unsigned int n, double* distances) const;
+    //true if VectorDistance is the plain euclidean distance between the points of two equal length
+    //vectors, capped at MaxDistance() when that's positive, so PerfectVectorStore can stand in for it
+    virtual bool EuclideanDistance() const { return false; }
+    virtual double MaxDistance() const { return 0; }
+    //true if the const methods, BestMatch included, are safe to call from several threads at once
+    virtual bool Shareable() const { return false; }
     virtual void SetSeed(unsigned int s) { generator.seed(s); }
-    virtual const char* BestMatch(InputVector& vector, Keyboard& k, WordList &w);
+    //for estimators that draw the noise themselves but should follow SetSeed()
+    boost::mt19937& Generator() { return generator; }
+    //changes whenever a setting that affects the model's vectors or distances changes, so results
+    //computed with it can be cached.  It only has to agree within one run.
+    virtual uint64_t Fingerprint() const = 0;
+    //an independent copy for use on another thread, or 0 if the model can't be copied that way
+    virtual InputModel* Clone() const { return 0; }
+    virtual ~InputModel() {}
+    virtual const char* BestMatch(InputVector& vector, Keyboard& k, WordList &w) const;
+    //the same search over a snapshot that other threads may be reading too
+    virtual const char* BestMatch(InputVector& vector, Keyboard& k, const FrozenWordList &w) const;
 };
 
 #endif
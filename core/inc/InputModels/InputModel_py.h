@@ -3,6 +3,10 @@
 #define InputModels_py_h
 
 #include "InputModels/InputModel.h"
+#include "FrozenWordList.h"
+#include "InputModels/InputVectorBatch.h"
+#include "ArrayView_py.h"
+#include "Hashing.h"
 
 //Boost include files
 #include <boost/python/class.hpp>
@@ -10,6 +14,8 @@
 #include <boost/python/pure_virtual.hpp>
 #include <boost/python/list.hpp>
 
+#include <string.h>
+
 using namespace boost::python;
 
 
@@ -21,22 +27,127 @@ list InputVectorList(InputVector& sigma) {
     }
     return l;
 }
+
+object InputVectorXArray(object self) {
+    InputVector& v = extract<InputVector&>(self);
+    return MakeArrayView(self, &v, v.XData(), std::vector<Py_ssize_t>(1, v.Length()));
+}
+
+object InputVectorYArray(object self) {
+    InputVector& v = extract<InputVector&>(self);
+    return MakeArrayView(self, &v, v.YData(), std::vector<Py_ssize_t>(1, v.Length()));
+}
+
+object InputVectorTArray(object self) {
+    InputVector& v = extract<InputVector&>(self);
+    return MakeArrayView(self, &v, v.TData(), std::vector<Py_ssize_t>(1, v.Length()));
+}
+
+unsigned int InputVectorAddPoint(InputVector& v, double x, double y, double t) {
+    CheckNoArrayViews(&v);
+    return v.AddPoint(x, y, t);
+}
+
+void InputVectorRemovePoint(InputVector& v, int i) {
+    CheckNoArrayViews(&v);
+    v.RemovePoint(i);
+}
+
+//takes anything exposing float64 (x, y, t) rows through the buffer protocol, e.g. an N x 3 numpy array
+void InputVectorSetPoints(InputVector& v, object points) {
+    CheckNoArrayViews(&v);
+    std::vector<double> values;
+    if(!ReadDoubleBuffer(points, values)) {
+        throw_error_already_set();
+    }
+    if(values.size() % 3 != 0) {
+        PyErr_SetString(PyExc_ValueError, "The points must be (x, y, t) rows.");
+        throw_error_already_set();
+    }
+    v.SetPoints(values.size() > 0 ? &values[0] : 0, values.size()/3);
+}
+/********************************************************/
+
+/***************** InputVectorBatch class ***************/
+object InputVectorBatchArray(object self) {
+    InputVectorBatch& b = extract<InputVectorBatch&>(self);
+    std::vector<Py_ssize_t> shape;
+    shape.push_back(b.Vectors());
+    shape.push_back(b.Points());
+    shape.push_back(3);
+    return MakeArrayView(self, &b, b.Data(), shape);
+}
+
+//the batch's methods that grow or clear it, refused while views of its array exist
+void InputVectorBatchReserve(InputVectorBatch& b, unsigned int n) {
+    CheckNoArrayViews(&b);
+    b.Reserve(n);
+}
+
+void InputVectorBatchClear(InputVectorBatch& b) {
+    CheckNoArrayViews(&b);
+    b.Clear();
+}
+
+bool InputVectorBatchAdd(InputVectorBatch& b, InputVector& v) {
+    CheckNoArrayViews(&b);
+    return b.Add(v);
+}
+
+unsigned int InputVectorBatchAddRandom(InputVectorBatch& b, InputModel& model, Keyboard& k, const char* word, unsigned int n) {
+    CheckNoArrayViews(&b);
+    return b.AddRandom(model, k, word, n);
+}
+
+unsigned int InputVectorBatchAddSamples(InputVectorBatch& b, InputModel& model, Keyboard& k, WordList& words, SampleSet& samples) {
+    CheckNoArrayViews(&b);
+    return b.AddSamples(model, k, words, samples);
+}
+
+template<typename T> void LoadFromFileWithoutViews(T& o, const std::string& filename) {
+    CheckNoArrayViews(&o);
+    LoadFromFile(o, filename);
+}
 /********************************************************/
 
 /***************** InputModel wrappers ******************/
+const char* (InputModel::*BestMatch1)(InputVector&, Keyboard&, WordList&) const = &InputModel::BestMatch;
+const char* (InputModel::*BestMatch2)(InputVector&, Keyboard&, const FrozenWordList&) const = &InputModel::BestMatch;
+InputVector (InputModel::*RandomVector1)(const char*, Keyboard&) = &InputModel::RandomVector;
+
 class InputModelWrapper : public InputModel, public boost::python::wrapper<InputModel> {
-    double Distance(InputVector& vector, const char* word, Keyboard& k) {
+    double Distance(InputVector& vector, const char* word, Keyboard& k) const {
         return this->get_override("Distance")(vector, word, k);
     }
-    double VectorDistance(InputVector& vector1, InputVector& vector2) {
+    double VectorDistance(InputVector& vector1, InputVector& vector2) const {
         return this->get_override("VectorDistance")(vector1, vector2);
     }
-    InputVector RandomVector(const char* word, Keyboard& k) {
+    //python models draw their own noise, so the generator goes unused
+    InputVector RandomVector(const char* word, Keyboard& k, boost::mt19937& generator) const {
         return this->get_override("RandomVector")(word, k);
     }
-    InputVector PerfectVector(const char* word, Keyboard& k) {
+    InputVector PerfectVector(const char* word, Keyboard& k) const {
         return this->get_override("PerfectVector")(word, k);
     }
+    //a python model's own Fingerprint if it has one, otherwise the object's identity, so changing its
+    //settings needs a new object or a Fingerprint to be seen by the cache
+    uint64_t Fingerprint() const {
+        if(override fingerprint = this->get_override("Fingerprint")) {
+            return HashCombine(HashString("python"), fingerprint());
+        }
+        return HashCombine(HashString("python"), uint64_t(uintptr_t(detail::wrapper_base_::get_owner(*this))));
+    }
+    //python models replaying a SampleSet get its offsets as a list, two per letter
+    InputVector OffsetVector(const char* word, Keyboard& k, const double* offsets) const {
+        if(override offset_vector = this->get_override("OffsetVector")) {
+            list l;
+            for(unsigned int i = 0; i < 2*strlen(word); i++) {
+                l.append(offsets[i]);
+            }
+            return offset_vector(word, k, l);
+        }
+        return InputModel::OffsetVector(word, k, offsets);
+    }
 };
 /********************************************************/
 
@@ -4,6 +4,7 @@
 #include "Keyboard.h"
 
 #include "boost/serialization/vector.hpp"
+#include <string>
 #include <vector>
 
 namespace boost {namespace serialization {class access;}}
@@ -14,6 +15,11 @@ class InputVector {
   public:
    unsigned int Length(); 
    unsigned int AddPoint(double x, double y, double t = 0);
+   //AddPoint for a point no earlier than the last, which just goes on the end
+   unsigned int Append(double x, double y, double t = 0);
+   //empties the vector but keeps its buffers, so refilling it up to the old length doesn't allocate
+   void Clear();
+   void Reserve(unsigned int n);
    void RemovePoint(int i);
    double X(int i);
    double Y(int i);
@@ -26,6 +32,18 @@ class InputVector {
    void SetX(int i, double x);
    void SetY(int i, double y);
    void SetT(int i, double t);
+   //replaces every point with the n (x, y, t) rows in points, ordered by t like AddPoint would
+   void SetPoints(const double* points, unsigned int n);
+
+   //direct access to the coordinate arrays, which move whenever points are added or removed
+   double* XData() { return xvector.size() > 0 ? &xvector[0] : 0; }
+   double* YData() { return yvector.size() > 0 ? &yvector[0] : 0; }
+   double* TData() { return tvector.size() > 0 ? &tvector[0] : 0; }
+
+   //the points as (x, y, t) in the fixed little-endian layout of PackedState.h
+   std::string PackState() const;
+   //returns false and leaves the vector as it was if data isn't a state PackState wrote
+   bool UnpackState(const char* data, size_t size);
 
   private:
     friend class boost::serialization::access;
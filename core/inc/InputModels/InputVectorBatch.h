@@ -0,0 +1,54 @@
+#ifndef InputVectorBatch_h
+#define InputVectorBatch_h
+
+#include "InputModels/InputModel.h"
+#include "InputModels/InputVector.h"
+#include "Keyboard.h"
+#include "SampleSet.h"
+#include "WordList.h"
+
+#include <string>
+#include <vector>
+#include "boost/serialization/vector.hpp"
+
+namespace boost {namespace serialization {class access;}}
+
+//Many input vectors with the same number of points stored back to back as one vectors x points x 3
+//array of (x, y, t) so they can be generated in bulk and handed to python as a single array.
+class InputVectorBatch {
+  private:
+    std::vector<double> data;
+    unsigned int points, vectors;
+
+  public:
+    //with points = 0 the first vector added sets it
+    InputVectorBatch(unsigned int points = 0);
+
+    unsigned int Vectors() const { return vectors; }
+    unsigned int Points() const { return points; }
+    double* Data() { return data.size() > 0 ? &data[0] : 0; }
+    void Reserve(unsigned int n) { data.reserve(3*points*n); }
+    void Clear() { data.clear(); vectors = 0; }
+
+    //false, adding nothing, if the vector doesn't have Points() points
+    bool Add(InputVector& v);
+    InputVector Get(unsigned int i) const;
+
+    //n noisy vectors of one word, returning how many were added
+    unsigned int AddRandom(InputModel& model, Keyboard& k, const char* word, unsigned int n);
+    //the vector the model makes for each sample in the set, which must have been drawn from words
+    unsigned int AddSamples(InputModel& model, Keyboard& k, WordList& words, SampleSet& samples);
+
+    //the shape and the array in the fixed little-endian layout of PackedState.h
+    std::string PackState() const;
+    //returns false and leaves the batch as it was if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
+
+  private:
+    friend class boost::serialization::access;
+    template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
+        ar & data & points & vectors;
+    }
+};
+
+#endif
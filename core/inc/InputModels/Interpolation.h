@@ -1,6 +1,22 @@
 #include "InputVector.h"
 //#include "InputModels/InputVector.h"
 
+//Each interpolation writes its Nsteps points over out, which mustn't be iv.  The intermediate vectors
+//are kept per thread, so once out and those have grown to fit nothing is allocated.
+void SpatialInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+
+void HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool monotonic, InputVector& out);
+void HermiteCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+void MonotonicCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+
+void CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool mod, InputVector& out);
+void CubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+void ModCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+
+void BezierInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+void BezierSloppyInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out);
+
+//the same returning a new vector
 InputVector SpatialInterpolation(InputVector& iv, unsigned int Nsteps);
 
 InputVector HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool monotonic);
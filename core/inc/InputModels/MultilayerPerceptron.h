@@ -0,0 +1,44 @@
+#ifndef MultilayerPerceptron_h
+#define MultilayerPerceptron_h
+
+#include <vector>
+#include <stdint.h>
+
+//A feed-forward network read from a FANN (FANN_FLO_2.x) save file and evaluated without the fann
+//library.  Each layer is stored as a dense weight block over the span of neurons that feed it, so
+//fully connected, sparse and shortcut networks all reduce to the same matrix multiply.  Rows are
+//evaluated in blocks with the batch index innermost, which the compiler vectorizes.
+class MultilayerPerceptron {
+    struct Layer {
+        unsigned int first, count;                 //neurons computed by this layer
+        unsigned int source_first, sources;        //contiguous span of neurons feeding them
+        std::vector<float> weights;                //count x sources, zero where there's no connection
+        std::vector<unsigned int> activation;
+        std::vector<float> steepness;
+        std::vector<bool> bias;                    //neurons without connections are bias neurons fixed at 1
+    };
+
+    std::vector<Layer> layers;
+    unsigned int neurons, inputs, outputs;
+    unsigned int input_bias, output_first;
+
+    void Activate(const Layer& layer, unsigned int n, float* sums, unsigned int rows) const;
+  public:
+    //rows evaluated together; the working block is neurons*block floats
+    static const unsigned int block = 64;
+
+    MultilayerPerceptron();
+    //returns false (and leaves the network empty) if the file can't be read
+    bool Load(const char *filename);
+    bool Empty() const { return layers.size() == 0; }
+    unsigned int Inputs() const { return inputs; }
+    unsigned int Outputs() const { return outputs; }
+    //a hash of the structure and every weight
+    uint64_t Fingerprint() const;
+
+    //in is rows x Inputs() and out is rows x Outputs(), both row-major
+    void Run(const float* in, float* out) const { RunBatch(in, 1, out); }
+    void RunBatch(const float* in, unsigned int rows, float* out) const;
+};
+
+#endif
@@ -2,22 +2,57 @@
 #define NeuralNetworkModel_h
 
 #include "InputModels/SimpleInterpolationModel.h"
+#include "InputModels/MultilayerPerceptron.h"
 
-struct fann;
+#include <vector>
+#include <stdint.h>
+
+//The terms of CreateInputs that depend only on the candidate vectors, for a set of candidates with the
+//same number of points.  Everything is stored point-major (point i of every candidate is contiguous) so
+//the feature loops run across candidates and vectorize without reordering any sums.
+class CandidateFeatures {
+  public:
+    unsigned int candidates, points;
+    std::vector<float> x, y, dx, dy, ddx, ddy;
+    std::vector<float> length;
+
+    CandidateFeatures() { candidates = points = 0; }
+    //every vector must have the same length, which needs to be at least 2
+    void Build(InputVector* vectors, unsigned int n);
+};
 
 class NeuralNetworkModel : public SimpleInterpolationModel {
   private:
-    struct fann *ann;
+    MultilayerPerceptron network;
     static unsigned int input_length;
 
+    //perfect vectors for every word of the last keyboard and word list BestMatch saw.  BestMatch
+    //updates them, which is why this model isn't Shareable and each thread uses its own Clone.
+    mutable CandidateFeatures candidates;
+    mutable uint64_t candidates_key;
+    template<typename Words> void UpdateCandidates(Keyboard& k, Words& w) const;
+    template<typename Words> const char* ClosestCandidate(InputVector& vector, Keyboard& k, Words& w) const;
+
   public:
     NeuralNetworkModel();
+    //throws std::runtime_error if SetANN fails
     NeuralNetworkModel(const char *filename, unsigned int vector_length = 50, double xscale = 0.5,
             double yscale = 0.5, double correlation = 0, double maxdistance = 0.0, double maxsigmas = 0.0, bool loop = false);
-    void SetANN(const char *filename);
+    //returns false and keeps the current network if the file can't be read or doesn't have
+    //InputLength() inputs and a single output
+    bool SetANN(const char *filename);
     static void CreateInputs(InputVector& v1, InputVector& v2, float* inputs);
-    double VectorDistance(InputVector& vector1, InputVector& vector2);
+    //CreateInputs(v, candidate, ...) for every candidate, written row-major into inputs
+    static void CreateInputsBatch(InputVector& v, const CandidateFeatures& c, float* inputs);
+    double VectorDistance(InputVector& vector1, InputVector& vector2) const;
+    void VectorDistanceBatch(InputVector& vector, InputVector* vectors, unsigned int n, double* distances) const;
+    const char* BestMatch(InputVector& vector, Keyboard& k, WordList &w) const;
+    const char* BestMatch(InputVector& vector, Keyboard& k, const FrozenWordList &w) const;
+    bool Shareable() const { return false; }
+    bool EuclideanDistance() const { return false; }
+    uint64_t Fingerprint() const;
     static unsigned int InputLength() { return input_length; }
+    InputModel* Clone() const { return new NeuralNetworkModel(*this); }
 };
 
 #endif
@@ -6,18 +6,30 @@
 class SimpleGaussianModel : public InputModel {
     double ysigma, xsigma;
     double correlation, correlation_complement;
+    InputVector PlaceVector(const char* word, Keyboard& k, const double* offsets) const;
   public:
     SimpleGaussianModel(double xscale = 0.5, double yscale = 0.5, double correlation = 0);
-    InputVector RandomVector(const char* word, Keyboard& k);
-    InputVector PerfectVector(const char* word, Keyboard& k);
-    double MarginalProbability( InputVector& sigma, const char* word, Keyboard& k);
-    double Distance( InputVector& sigma, const char* word, Keyboard& k);
-    double VectorDistance(InputVector& vector1, InputVector& vector2);
+    using InputModel::RandomVector;
+    InputVector RandomVector(const char* word, Keyboard& k, boost::mt19937& generator) const;
+    InputVector PerfectVector(const char* word, Keyboard& k) const;
+    //the same written over out, which doesn't allocate once out has grown to fit
+    void RandomVector(const char* word, Keyboard& k, boost::mt19937& generator, InputVector& out) const;
+    void PerfectVector(const char* word, Keyboard& k, InputVector& out) const { PlaceVector(word, k, 0, out); }
+    //the key centres moved by offsets standard deviations, with no offsets meaning none
+    void PlaceVector(const char* word, Keyboard& k, const double* offsets, InputVector& out) const;
+    InputVector OffsetVector(const char* word, Keyboard& k, const double* offsets) const { return PlaceVector(word, k, offsets); }
+    double MarginalProbability( InputVector& sigma, const char* word, Keyboard& k) const;
+    double Distance( InputVector& sigma, const char* word, Keyboard& k) const;
+    double VectorDistance(InputVector& vector1, InputVector& vector2) const;
+    bool EuclideanDistance() const { return true; }
+    bool Shareable() const { return true; }
     void SetXScale(double xscale) { xsigma = xscale*0.5; }
     void SetYScale(double yscale) { ysigma = yscale*0.5; }
-    double XScale() { return xsigma*2.0; }
-    double YScale() { return ysigma*2.0; }
+    double XScale() const { return xsigma*2.0; }
+    double YScale() const { return ysigma*2.0; }
     void SetCorrelation(double corr);
     void SetScale(double scale) { SetXScale(scale); SetYScale(scale); }
+    uint64_t Fingerprint() const;
+    InputModel* Clone() const { return new SimpleGaussianModel(*this); }
 };
 #endif
@@ -4,9 +4,11 @@
 #include "InputModels/InputModel.h"
 #include "InputModels/SimpleGaussianModel.h"
 
+#include <stdint.h>
+
 class SimpleInterpolationModel : public InputModel {
     SimpleGaussianModel model;
-    InputVector (*interpolation)(InputVector&, unsigned int);
+    void (*interpolation)(InputVector&, unsigned int, InputVector&);
 
     double ysigma, xsigma;
     double maxd, maxd2, maxs;
@@ -14,11 +16,20 @@ class SimpleInterpolationModel : public InputModel {
     bool loop_letter;
   public:
     SimpleInterpolationModel(unsigned int vector_length = 50, double xscale = 0.5, double yscale = 0.5, double correlation = 0, double maxdistance = 0.0, double maxsigmas = 0.0, bool loop = false);
-    InputVector RandomVector(const char* word, Keyboard& k);
-    InputVector PerfectVector(const char* word, Keyboard& k);
+    using InputModel::RandomVector;
+    InputVector RandomVector(const char* word, Keyboard& k, boost::mt19937& generator) const;
+    InputVector PerfectVector(const char* word, Keyboard& k) const;
+    InputVector OffsetVector(const char* word, Keyboard& k, const double* offsets) const;
     double MarginalProbability( InputVector& sigma, const char* word, Keyboard& k);
-    double Distance( InputVector& sigma, const char* word, Keyboard& k);
-    double VectorDistance(InputVector& vector1, InputVector& vector2);
+    double Distance( InputVector& sigma, const char* word, Keyboard& k) const;
+    //the vector Distance compares against, which unlike PerfectVector leaves double letters alone
+    InputVector ReferenceVector(const char* word, Keyboard& k) const;
+    //the same written over out, which doesn't allocate once out has grown to fit
+    void ReferenceVector(const char* word, Keyboard& k, InputVector& out) const;
+    double VectorDistance(InputVector& vector1, InputVector& vector2) const;
+    bool EuclideanDistance() const { return true; }
+    bool Shareable() const { return true; }
+    double MaxDistance() const { return maxd; }
     void SetXScale(double xscale) { model.SetXScale(xscale); }
     void SetYScale(double yscale) { model.SetYScale(yscale); }
     void SetScale(double scale) { SetXScale(scale); SetYScale(scale); }
@@ -26,8 +37,17 @@ class SimpleInterpolationModel : public InputModel {
     void SetMaxDistance(double maxdistance) { maxd = maxdistance; maxd2 = maxd*maxd; }
     void SetVectorLength(unsigned int vector_length) { vlength = vector_length; }
     void SetLoops(bool loop) { loop_letter = loop; }
-    void SetInterpolationFunction(InputVector (*fun)(InputVector&, unsigned int)) { interpolation = fun; }
-    virtual InputVector Interpolation(InputVector& iv, unsigned int N) const;
-    void SetSeed(unsigned int s);
+    void SetInterpolationFunction(void (*fun)(InputVector&, unsigned int, InputVector&)) { interpolation = fun; }
+    unsigned int VectorLength() const { return vlength; }
+    double MaxSigmas() const { return maxs; }
+    //changes whenever a setting PerfectVector depends on (besides the keyboard and word) changes
+    uint64_t PerfectSettingsHash() const;
+    //PerfectSettingsHash with the noise, the maximum distance and the maximum sigmas as well
+    uint64_t Fingerprint() const;
+    //writes the N point curve through iv over out, which mustn't be iv.  The letter points come from
+    //per-thread scratch, so an override mustn't call back into the model's vector methods before it's
+    //done reading iv.
+    virtual void Interpolation(InputVector& iv, unsigned int N, InputVector& out) const;
+    InputModel* Clone() const { return new SimpleInterpolationModel(*this); }
 };
 #endif
@@ -3,14 +3,25 @@
 
 #include "InputModels/SimpleInterpolationModel.h"
 #include "InputModels/Interpolation.h"
+#include "Hashing.h"
 
 #include <boost/python/wrapper.hpp>
 #include <boost/python/pure_virtual.hpp>
 #include <boost/python/call_method.hpp>
 #include <boost/python/str.hpp>
+#include <boost/python/object.hpp>
+#include <boost/python/handle.hpp>
+#include <boost/python/converter/registered.hpp>
 
 using namespace boost::python;
 
+InputVector (*SpatialInterpolation1)(InputVector&, unsigned int) = &SpatialInterpolation;
+InputVector (*MonotonicCubicSplineInterpolation1)(InputVector&, unsigned int) = &MonotonicCubicSplineInterpolation;
+InputVector (*HermiteCubicSplineInterpolation1)(InputVector&, unsigned int) = &HermiteCubicSplineInterpolation;
+InputVector (*CubicSplineInterpolation1)(InputVector&, unsigned int) = &CubicSplineInterpolation;
+InputVector (*ModCubicSplineInterpolation1)(InputVector&, unsigned int) = &ModCubicSplineInterpolation;
+InputVector (*BezierInterpolation1)(InputVector&, unsigned int) = &BezierInterpolation;
+InputVector (*BezierSloppyInterpolation1)(InputVector&, unsigned int) = &BezierSloppyInterpolation;
 
 bool SetInterpolationByName(SimpleInterpolationModel& model, str name) {
     if(name == "bezier") {
@@ -34,15 +45,43 @@ struct SimpleInterpolationModelCallback : SimpleInterpolationModel {
     SimpleInterpolationModelCallback(PyObject *p, const SimpleInterpolationModel& m) 
         : SimpleInterpolationModel(), self(p) {}
 
-    InputVector Interpolation(InputVector& iv, unsigned int N) const {
-        return call_method<InputVector>(self, "Interpolation", iv, N);
+    void Interpolation(InputVector& iv, unsigned int N, InputVector& out) const {
+        out = call_method<InputVector>(self, "Interpolation", iv, N);
     }
+    //a python override of Interpolation can't be called from worker threads, otherwise the
+    //plain model is an exact copy.  This must be called while holding the GIL.
+    InputModel* Clone() const {
+        if(OverridesInterpolation()) {
+            return 0;
+        }
+        return new SimpleInterpolationModel(*this);
+    }
+    //an overridden Interpolation is told apart by the object it belongs to
+    uint64_t Fingerprint() const {
+        const uint64_t h = SimpleInterpolationModel::Fingerprint();
+        return OverridesInterpolation() ? HashCombine(h, uint64_t(uintptr_t(self))) : h;
+    }
+    //Interpolation goes through python even when it isn't overridden, so only the clones are shareable
+    bool Shareable() const { return false; }
+    //python keeps the signature returning the new vector
     static InputVector default_Interpolation(const SimpleInterpolationModel& self_, InputVector& iv, unsigned int N)  {
-        return self_.SimpleInterpolationModel::Interpolation(iv, N);
+        InputVector out;
+        self_.SimpleInterpolationModel::Interpolation(iv, N, out);
+        return out;
     }
 
   private:
     PyObject* self; // 1
+
+    bool OverridesInterpolation() const {
+        object base(handle<>(borrowed(converter::registered<SimpleInterpolationModel>::converters.get_class_object())));
+        object method = object(handle<>(borrowed(self))).attr("Interpolation");
+        if(!PyObject_HasAttrString(method.ptr(), "__func__")) {
+            return true;
+        }
+        object function = method.attr("__func__"), default_function = base.attr("Interpolation");
+        return function.ptr() != default_function.ptr();
+    }
 };
 /********************************************************/
 
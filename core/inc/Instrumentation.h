@@ -0,0 +1,85 @@
+#ifndef Instrumentation_h
+#define Instrumentation_h
+
+#include <stdint.h>
+
+//Counts and times of the hot paths, compiled in only when the library is configured with
+//-Dinstrumentation=ON (which defines DODONA_INSTRUMENTATION).  Otherwise DODONA_COUNT and DODONA_TIME
+//expand to nothing and every Stats is empty.  Each thread keeps its own counters, which only it
+//writes, and they are added up on request; a thread's counters are kept when it finishes.
+namespace Instrumentation {
+    enum Counter {
+        RandomVector, PerfectVector, Interpolation, Distance, VectorDistance,
+        //words compared by BestMatch and words returned by RadixTree::Matches
+        BestMatchCandidates, RadixMatches,
+        //WordList rebuilding its sorted vectors or its tree
+        UpdateVectors, UpdateTree,
+        //InputVector buffers growing
+        Allocations,
+        NCounters
+    };
+    const char* CounterName(unsigned int counter);
+
+    class Stats {
+      public:
+        uint64_t counts[NCounters];
+        //0 for the counters that are only counted
+        uint64_t nanoseconds[NCounters];
+
+        Stats();
+        Stats& operator+=(const Stats& other);
+        Stats operator-(const Stats& other) const;
+        bool Empty() const;
+    };
+
+    //true if the library was built with instrumentation
+    bool Enabled();
+    //what the calling thread has counted so far
+    Stats ThreadStats();
+    //what every thread, running or finished, has counted since the last Reset
+    Stats Aggregate();
+    void Reset();
+
+#ifdef DODONA_INSTRUMENTATION
+    //the calling thread's counters.  The owning thread is the only writer, so relaxed loads and
+    //stores are enough and cost no more than plain ones.
+    class ThreadCounters;
+    ThreadCounters& Local();
+    void Add(ThreadCounters& local, Counter counter, uint64_t n, uint64_t nanoseconds);
+    inline void Count(Counter counter, uint64_t n) { Add(Local(), counter, n, 0); }
+    uint64_t Now();
+
+    //counts one call and its duration when it goes out of scope
+    class Timer {
+        Counter counter;
+        uint64_t start;
+      public:
+        explicit Timer(Counter c) : counter(c), start(Now()) {}
+        ~Timer() { Add(Local(), counter, 1, Now() - start); }
+    };
+
+    //what the calling thread counts between construction and Attach
+    class Scope {
+        Stats start;
+      public:
+        Scope() : start(ThreadStats()) {}
+        template<typename Result> Result Attach(Result result) const {
+            result.SetStats(ThreadStats() - start);
+            return result;
+        }
+    };
+
+    #define DODONA_COUNT(counter, n) Instrumentation::Count(Instrumentation::counter, n)
+    #define DODONA_TIME(counter) Instrumentation::Timer dodona_timer_##counter(Instrumentation::counter)
+#else
+    class Scope {
+      public:
+        template<typename Result> Result Attach(Result result) const { return result; }
+    };
+
+    #define DODONA_COUNT(counter, n) ((void) 0)
+    #define DODONA_TIME(counter) ((void) 0)
+#endif
+};
+
+#endif
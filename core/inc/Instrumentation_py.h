@@ -0,0 +1,32 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef Instrumentation_py_h
+#define Instrumentation_py_h
+
+#include "Instrumentation.h"
+#include "FitnessResult.h"
+
+#include <boost/python/dict.hpp>
+
+using namespace boost::python;
+
+//{counter name: {"count": n, "seconds": s}}, with seconds only for the timed counters
+dict InstrumentationStatsDict(const Instrumentation::Stats& stats) {
+    dict d;
+    for(unsigned int c = 0; c < Instrumentation::NCounters; c++) {
+        dict counter;
+        counter["count"] = stats.counts[c];
+        if(stats.nanoseconds[c] > 0) counter["seconds"] = 1e-9*double(stats.nanoseconds[c]);
+        d[Instrumentation::CounterName(c)] = counter;
+    }
+    return d;
+}
+
+dict FitnessResultStats(FitnessResult& result) {
+    return InstrumentationStatsDict(result.GetStats());
+}
+
+dict InstrumentationAggregate() {
+    return InstrumentationStatsDict(Instrumentation::Aggregate());
+}
+
+#endif
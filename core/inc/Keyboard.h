@@ -3,6 +3,9 @@
 
 #include "Polygon.h"
 
+#include <stdint.h>
+#include <string>
+
 #include <boost/random/mersenne_twister.hpp>
 
 namespace boost {namespace serialization {class access;}}
@@ -13,10 +16,17 @@ class Keyboard {
     unsigned int idx;
     unsigned char entries[128];
     boost::mt19937 generator;
+    //Zobrist-style layout hash: the xor over the keys of a term for (character, polygon hash), kept
+    //up to date by every modification so that swaps cost O(1)
+    uint64_t key_hashes[128];
+    uint64_t hash;
+    void SwapIndices(const unsigned int i1, const unsigned int i2);
+    void Rehash();
   public:
     Keyboard();
     Keyboard(const Keyboard& k);
-    bool operator==(const Keyboard& other);
+    //true if every character is on the same polygon in both
+    bool operator==(const Keyboard& other) const;
     void AddKey(const unsigned char c, const Polygon& p);
     void RemoveKey(const unsigned char c);
     Polygon GetKey(const unsigned char c) const;
@@ -29,11 +39,22 @@ class Keyboard {
     void RandomNoop();
     void SetSeed(unsigned int s) { generator.seed(s); }
     void Reset();
+    //identifies the layout: which polygon every character is on, independent of the key order
+    uint64_t Hash() const { return hash; }
+
+    //the characters in key order, each with its polygon's state, in the fixed little-endian layout of
+    //PackedState.h.  The generator isn't saved, as with the text archive.
+    std::string PackState() const;
+    //returns false and leaves the keyboard as it was if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
 
   private:
     friend class boost::serialization::access;
     template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
         ar & idx & polygons & entries;
+        if(Archive::is_loading::value) {
+            Rehash();
+        }
     }
 };
 
@@ -3,6 +3,7 @@
 #define Keyboard_py_h
 
 #include "Keyboard.h"
+#include "StandardKeyboards.h"
 
 #include <string>
 
@@ -11,9 +12,15 @@
 #include <boost/python/list.hpp>
 #include <boost/python/dict.hpp>
 #include <boost/python/str.hpp>
+#include <boost/python/overloads.hpp>
 
 using namespace boost::python;
 
+BOOST_PYTHON_FUNCTION_OVERLOADS(Qwerty_overloads, StandardKeyboards::Qwerty, 0, 1)
+BOOST_PYTHON_FUNCTION_OVERLOADS(Dvorak_overloads, StandardKeyboards::Dvorak, 0, 1)
+BOOST_PYTHON_FUNCTION_OVERLOADS(Hexagonal_overloads, StandardKeyboards::Hexagonal, 0, 2)
+BOOST_PYTHON_FUNCTION_OVERLOADS(T9_overloads, StandardKeyboards::T9, 0, 2)
+
 
 dict KeyboardPolygonDict(Keyboard& k) {
     dict d;
@@ -0,0 +1,81 @@
+#ifndef NGramModel_h
+#define NGramModel_h
+
+#include "IngestOptions.h"
+
+#include <string>
+#include <vector>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/unordered_map.hpp>
+#include <stdint.h>
+
+//Word unigram, bigram and trigram counts for use as a language model prior when decoding.  Words get
+//integer ids and n-grams and contexts are keyed by a 64-bit hash of their ids, so a model takes about
+//12 bytes per distinct n-gram and 16 per distinct context once prepared.  Prepared tables are sorted
+//arrays that Save writes out as they are and Load memory maps in place, without reading them.
+//
+//Probabilities are interpolated absolute discounting (with discount 0.75) down to add-one smoothed
+//unigrams, so every word, including ones never seen, has a nonzero probability in every context.
+class NGramModel {
+  public:
+    //the id of words the model has never seen
+    static const uint32_t unknown = 0xffffffff;
+
+  private:
+    unsigned int order;
+    uint64_t total;
+    std::vector<std::string> vocabulary;
+    boost::unordered_map<std::string, uint32_t> ids;
+
+    //counts while the model is being built
+    boost::unordered_map<uint64_t, uint32_t> building_ngrams;
+    boost::unordered_map<uint64_t, std::pair<uint32_t, uint32_t> > building_contexts;
+    bool prepared;
+
+    //the prepared tables, sorted by key, either held here or in the mapped file at the offsets below
+    std::vector<uint32_t> unigrams;
+    std::vector<uint64_t> ngram_keys, context_keys;
+    std::vector<uint32_t> ngram_counts, context_totals, context_types;
+    boost::iostreams::mapped_file_source mapped;
+    uint64_t ngrams, contexts;
+    uint64_t unigram_offset, ngram_key_offset, ngram_count_offset, context_key_offset, context_total_offset, context_type_offset;
+
+    template<typename T> const T* Table(const std::vector<T>& owned, uint64_t offset) const;
+    uint32_t AddId(const std::string& word);
+    //counts the n-grams ending at each word of a stream of ids
+    void AddIds(const std::vector<uint32_t>& stream);
+    //moves prepared or mapped tables back into the building maps so more text can be added
+    void Unprepare();
+    uint32_t NGramCount(uint64_t key) const;
+    bool ContextCounts(uint64_t key, uint32_t& context_total, uint32_t& context_types) const;
+    double UnigramProbability(uint32_t w) const;
+
+  public:
+    //order is clamped to [1, 3]
+    NGramModel(unsigned int order = 3);
+
+    //counts the n-grams of one stream of words, whose first words have no context
+    void AddWords(const std::vector<std::string>& words);
+    //treats each file as one stream of words, tokenized like WordList::IngestFiles, returning how many were added
+    unsigned int IngestFiles(const std::vector<std::string>& paths, const IngestOptions& options = IngestOptions());
+    //sorts the counts into their compact tables, which every query does first if needed
+    void Prepare();
+
+    unsigned int Order() const { return order; }
+    unsigned int VocabularySize() const { return vocabulary.size(); }
+    uint64_t TotalWords() const { return total; }
+    uint64_t NGrams();
+    uint32_t WordId(const char* word) const;
+    const char* Word(uint32_t id) const { return vocabulary[id].c_str(); }
+
+    //log P(w | u v) by word id, with unknown for a missing or unknown context word.  Not thread-safe
+    //unless the model has been prepared.
+    double LogProbability(uint32_t u, uint32_t v, uint32_t w);
+    //the probability of word following the last (up to order - 1) words of context
+    double Probability(const std::vector<std::string>& context, const char* word);
+
+    bool Save(const std::string& filename);
+    bool Load(const std::string& filename);
+};
+
+#endif
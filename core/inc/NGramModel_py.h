@@ -0,0 +1,66 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef NGramModel_py_h
+#define NGramModel_py_h
+
+#include "NGramModel.h"
+#include "InputModels/ContextDecoder.h"
+
+#include <string>
+#include <vector>
+
+#include <boost/python/list.hpp>
+
+using namespace boost::python;
+
+//any python sequence of strings
+std::vector<std::string> StringVector(object strings) {
+    std::vector<std::string> v;
+    for(unsigned int i = 0; i < len(strings); i++) {
+        v.push_back(extract<std::string>(strings[i]));
+    }
+    return v;
+}
+
+list StringList(const std::vector<std::string>& v) {
+    list l;
+    for(unsigned int i = 0; i < v.size(); i++) {
+        l.append(v[i]);
+    }
+    return l;
+}
+
+void NGramModelAddWords(NGramModel& lm, object words) {
+    lm.AddWords(StringVector(words));
+}
+
+unsigned int NGramModelIngestFiles(NGramModel& lm, object paths, const IngestOptions& options) {
+    return lm.IngestFiles(StringVector(paths), options);
+}
+
+unsigned int NGramModelIngestFiles1(NGramModel& lm, object paths) {
+    return lm.IngestFiles(StringVector(paths));
+}
+
+double NGramModelProbability(NGramModel& lm, object context, const char* word) {
+    return lm.Probability(StringVector(context), word);
+}
+
+const char* ContextDecoderBestMatch(ContextDecoder& d, InputModel& model, InputVector& vector, Keyboard& k, WordList& w,
+        NGramModel& lm, object context) {
+    return d.BestMatch(model, vector, k, w, lm, StringVector(context));
+}
+
+list ContextDecoderDecode(ContextDecoder& d, InputModel& model, object vectors, Keyboard& k, WordList& w, NGramModel& lm) {
+    std::vector<InputVector> v;
+    for(unsigned int i = 0; i < len(vectors); i++) {
+        v.push_back(extract<InputVector&>(vectors[i]));
+    }
+    return StringList(d.Decode(model, v, k, w, lm));
+}
+
+DecodingReport ContextDecoderAccuracy(ContextDecoder& d, InputModel& model, Keyboard& k, WordList& w, NGramModel& lm,
+        object text, unsigned int seed) {
+    return d.Accuracy(model, k, w, lm, StringVector(text), seed);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef PackedState_h
+#define PackedState_h
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+//The fixed little-endian layout the core classes pickle to, which reads back the same on any platform:
+//an 8 byte magic naming the class, a uint32 version, then the class's fields.  Integers are written
+//least significant byte first, doubles as their IEEE bits, strings and nested states as a uint64
+//length followed by their bytes.
+class StateWriter {
+    std::string out;
+
+    template<typename T> void PutLittle(T value) {
+        for(unsigned int b = 0; b < sizeof(T); b++) {
+            out += char((value >> 8*b) & 0xff);
+        }
+    }
+  public:
+    StateWriter(const char* magic, uint32_t version) {
+        out.append(magic, 8);
+        PutLittle(version);
+    }
+    void Reserve(size_t n) { out.reserve(out.size() + n); }
+
+    void PutU8(uint8_t value) { PutLittle(value); }
+    void PutU32(uint32_t value) { PutLittle(value); }
+    void PutU64(uint64_t value) { PutLittle(value); }
+    void PutDouble(double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        PutLittle(bits);
+    }
+    void PutBytes(const char* data, size_t n) {
+        PutLittle((uint64_t) n);
+        out.append(data, n);
+    }
+    void PutString(const std::string& s) { PutBytes(s.data(), s.size()); }
+
+    const std::string& State() const { return out; }
+};
+
+//Every Get returns false, leaving the value alone, once the data runs out, so a reader can parse a
+//whole state and check for truncation once at the end.
+class StateReader {
+    const char *data;
+    size_t size, position;
+    bool valid;
+
+    template<typename T> bool GetLittle(T& value) {
+        if(!valid || size - position < sizeof(T)) return valid = false;
+        value = 0;
+        for(unsigned int b = 0; b < sizeof(T); b++) {
+            value |= T((unsigned char) data[position + b]) << 8*b;
+        }
+        position += sizeof(T);
+        return true;
+    }
+  public:
+    //Valid() is false unless data starts with magic and this version
+    StateReader(const char* data, size_t size, const char* magic, uint32_t version) : data(data), size(size), position(8), valid(true) {
+        uint32_t v = 0;
+        valid = size >= 8 && memcmp(data, magic, 8) == 0 && GetLittle(v) && v == version;
+    }
+    bool Valid() const { return valid; }
+    //true if everything was read without running out and nothing is left over
+    bool Finished() const { return valid && position == size; }
+    size_t Remaining() const { return valid ? size - position : 0; }
+    //false if n items of at least element bytes each can't be left, which catches corrupt counts
+    //before anything is allocated for them
+    bool Fits(uint64_t n, size_t element) const { return valid && n <= (size - position)/element; }
+
+    bool GetU8(uint8_t& value) { return GetLittle(value); }
+    bool GetU32(uint32_t& value) { return GetLittle(value); }
+    bool GetU64(uint64_t& value) { return GetLittle(value); }
+    bool GetDouble(double& value) {
+        uint64_t bits;
+        if(!GetLittle(bits)) return false;
+        memcpy(&value, &bits, sizeof(bits));
+        return true;
+    }
+    //points bytes at the next n bytes of the data, without copying them
+    bool GetBytes(const char*& bytes, size_t& n) {
+        uint64_t length = 0;
+        if(!GetLittle(length) || length > size - position) return valid = false;
+        bytes = data + position;
+        n = length;
+        position += length;
+        return true;
+    }
+    bool GetString(std::string& s) {
+        const char *bytes = 0;
+        size_t n = 0;
+        if(!GetBytes(bytes, n)) return false;
+        s.assign(bytes, n);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef PerfectVectorIndex_h
+#define PerfectVectorIndex_h
+
+#include "InputModels/InputVector.h"
+
+#include <vector>
+
+//A vantage point tree over a set of equal length vectors (usually the perfect vectors for a word list
+//on one keyboard) for finding every vector within a radius of a query.  Each node splits the vectors
+//below it at their median distance from it, so by the triangle inequality a query only descends into
+//the halves its radius reaches.  Distances are euclidean over the points, summed in the same order as
+//SimpleInterpolationModel::VectorDistance so that they agree with it exactly below its cap.
+class PerfectVectorIndex {
+    unsigned int vectors, points;
+    //x and y of every point, one vector after another
+    std::vector<double> coordinates;
+    //the vectors in tree order: a node at position b with children in (b, e) keeps the ones closer
+    //than radius[b] in (b, middle) and the rest in [middle, e)
+    std::vector<unsigned int> order;
+    std::vector<double> radius;
+
+    double Distance(const double* a, const double* b) const;
+    void BuildNode(unsigned int begin, unsigned int end);
+    void Within(const double* query, double r, unsigned int begin, unsigned int end,
+            std::vector<unsigned int>& neighbours, std::vector<double>& distances) const;
+  public:
+    PerfectVectorIndex();
+    //false (leaving the index empty) if the vectors don't all have the same length
+    bool Build(InputVector* v, unsigned int n);
+    unsigned int Vectors() const { return vectors; }
+    unsigned int Points() const { return points; }
+
+    //the index and distance of every vector closer than r to the query, or to stored vector i, in no
+    //particular order.  Both are cleared first.
+    void Within(InputVector& query, double r, std::vector<unsigned int>& neighbours, std::vector<double>& distances) const;
+    void Within(unsigned int i, double r, std::vector<unsigned int>& neighbours, std::vector<double>& distances) const;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef PerfectVectorStore_h
+#define PerfectVectorStore_h
+
+#include "InputModels/InputModel.h"
+#include "InputModels/InputVector.h"
+#include "Keyboard.h"
+#include "WordList.h"
+
+#include <vector>
+#include <stdint.h>
+
+//How many queries changed their best match when compared against a reduced precision store
+class PrecisionReport {
+  public:
+    unsigned int samples, changed;
+    double max_error, mean_error;
+
+    PrecisionReport() : samples(0), changed(0), max_error(0), mean_error(0) {}
+    double ChangeRate() const { return samples > 0 ? double(changed)/double(samples) : 0; }
+};
+
+//A block of equal length vectors (usually the perfect vectors for a word list on one keyboard) kept
+//at double, float or int16 precision for euclidean distance queries.  Only the x and y coordinates
+//are stored, point-major (coordinate i of every vector is contiguous) so the distance loops run
+//across vectors and vectorize.  The int16 store quantizes both axes with one shared scale so that
+//distances stay isotropic.  Its range is twice the extent of the stored vectors and queries beyond
+//that are clamped.
+class PerfectVectorStore {
+  public:
+    enum Precision { Double, Float, Int16 };
+
+  private:
+    Precision precision;
+    unsigned int vectors, points;
+    std::vector<double> doubles;
+    std::vector<float> floats;
+    std::vector<int16_t> shorts;
+    double offset, scale;
+
+  public:
+    PerfectVectorStore(Precision p = Float);
+    //false (leaving the store empty) if the vectors don't all have the same length
+    bool Build(InputVector* v, unsigned int n);
+    bool Build(InputModel& model, Keyboard& keyboard, WordList& words);
+
+    Precision GetPrecision() const { return precision; }
+    unsigned int Vectors() const { return vectors; }
+    unsigned int Points() const { return points; }
+    unsigned int Bytes() const;
+
+    //distances[i] = sqrt of the summed squared point differences to vector i, capped at maxdistance if positive
+    void Distances(InputVector& query, double* distances, double maxdistance = 0) const;
+    //the index of the closest vector, the first one on ties
+    unsigned int Nearest(InputVector& query) const;
+
+    //draws samples random vectors for words of the list and reports how often their nearest
+    //perfect vector at precision p differs from the one found at double precision
+    static PrecisionReport Validate(InputModel& model, Keyboard& keyboard, WordList& words, Precision p,
+            unsigned int samples, unsigned int seed = 0);
+};
+
+#endif
@@ -0,0 +1,30 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef PerfectVectorStore_py_h
+#define PerfectVectorStore_py_h
+
+#include "PerfectVectorStore.h"
+
+#include <vector>
+
+#include <boost/python/list.hpp>
+
+using namespace boost::python;
+
+bool (PerfectVectorStore::*PerfectVectorStoreBuild)(InputModel&, Keyboard&, WordList&) = &PerfectVectorStore::Build;
+
+list PerfectVectorStoreDistances(PerfectVectorStore& store, InputVector& query, double maxdistance) {
+    std::vector<double> distances(store.Vectors());
+    if(distances.size() > 0) store.Distances(query, &distances[0], maxdistance);
+
+    list l;
+    for(unsigned int i = 0; i < distances.size(); i++) {
+        l.append(distances[i]);
+    }
+    return l;
+}
+
+list PerfectVectorStoreDistances1(PerfectVectorStore& store, InputVector& query) {
+    return PerfectVectorStoreDistances(store, query, 0);
+}
+
+#endif
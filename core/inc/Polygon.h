@@ -1,8 +1,10 @@
 #ifndef Polygon_h
 #define Polygon_h
 
+#include <string>
 #include <vector>
 #include <utility>
+#include <stdint.h>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/utility.hpp>
 
@@ -15,7 +17,7 @@ class Polygon {
   public:
     Polygon();
     Polygon(const Polygon& p);
-    bool operator==(const Polygon& other);
+    bool operator==(const Polygon& other) const;
     void Translate(double x, double y);
     unsigned int AddVertex(double x, double y);
     unsigned int ReplaceVertex(unsigned int i, double x, double y);
@@ -27,8 +29,14 @@ class Polygon {
     double TopExtreme() const;
     double BottomExtreme() const;
     bool IsInside(double x, double y);
+    uint64_t Hash() const;
     void Reset();
 
+    //the vertices in the fixed little-endian layout of PackedState.h
+    std::string PackState() const;
+    //returns false and leaves the polygon as it was if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
+
   private:
     //allow serialization to access non-public data members.
     friend class boost::serialization::access;
@@ -9,15 +9,15 @@ class RadixTree {
     RadixTree *nodes[256];
     unsigned int entries;
     bool firstlast;
-    char* ArrangeWord(const char* word);
-    std::vector<std::string> MatchesHelper(const char* stringform, bool termination);
+    char* ArrangeWord(const char* word) const;
+    std::vector<std::string> MatchesHelper(const char* stringform, bool termination) const;
   public:
     RadixTree(bool firstlast = false);
     ~RadixTree();
     //returns false if the word already exists
     bool AddWord(const char* word);
-    bool CheckWord(const char* word);
-    std::vector<std::string> Matches(const char* stringform);
+    bool CheckWord(const char* word) const;
+    std::vector<std::string> Matches(const char* stringform) const;
     void Reset();
 };
 
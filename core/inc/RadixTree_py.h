@@ -9,7 +9,7 @@
 #include <boost/python/str.hpp>
 using namespace boost::python;
 
-list RadixTreeMatches(RadixTree& tree, const char* stringform) {
+list RadixTreeMatches(const RadixTree& tree, const char* stringform) {
     std::vector<std::string> results = tree.Matches(stringform);
     list l;
     for(unsigned int i = 0; i < results.size(); i++) {
@@ -0,0 +1,117 @@
+#ifndef ResultsLog_h
+#define ResultsLog_h
+
+#include "DataFormat.h"
+#include "FitnessResult.h"
+#include "Keyboard.h"
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "boost/serialization/string.hpp"
+#include <boost/unordered_map.hpp>
+#include <stdint.h>
+
+namespace boost {namespace serialization {class access;}}
+
+//An append-only alternative to saving a whole DataFormat: results are written to disk as they're
+//produced and read back one at a time.  The file is a short header, a metadata record (an empty
+//DataFormat carrying the word list and model names) and then chunks of results.  Every record is
+//length prefixed and checksummed, so a chunk cut short by a crash is simply dropped when the log is
+//read or reopened for appending.
+
+//one result, as passed to DataFormat::AddEntry
+class ResultsLogEntry {
+  public:
+    Keyboard keyboard;
+    std::string efficiency;
+    FitnessResult result;
+
+    ResultsLogEntry() {}
+    ResultsLogEntry(Keyboard& k, std::string effType, FitnessResult eff) : keyboard(k), efficiency(effType), result(eff) {}
+
+  private:
+    friend class boost::serialization::access;
+    template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
+        ar & keyboard & efficiency & result;
+    }
+};
+
+class ResultsLogWriter {
+    std::ofstream file;
+    std::vector<ResultsLogEntry> pending;
+    unsigned int chunk_entries, written;
+
+    ResultsLogWriter(const ResultsLogWriter&);
+    ResultsLogWriter& operator=(const ResultsLogWriter&);
+  public:
+    //starts a new log at filename (replacing any file there) with the metadata and any entries of format
+    ResultsLogWriter(const std::string& filename, DataFormat& format, unsigned int chunk_entries = 256);
+    //reopens an existing log to append to it
+    ResultsLogWriter(const std::string& filename, unsigned int chunk_entries = 256);
+    ~ResultsLogWriter();
+
+    bool Good() const { return file.is_open() && file.good(); }
+    //entries are written a chunk at a time, or sooner with Flush()
+    void Add(Keyboard& k, std::string effType, FitnessResult eff);
+    void Flush();
+    //entries added through this writer, including any not flushed yet
+    unsigned int Entries() const { return written + pending.size(); }
+};
+
+class ResultsLogReader {
+    std::ifstream file;
+    DataFormat metadata;
+    std::streamoff data_start, chunk_offset;
+    std::vector<ResultsLogEntry> chunk;
+    unsigned int position;
+    bool good;
+
+    bool NextChunk();
+    ResultsLogReader(const ResultsLogReader&);
+    ResultsLogReader& operator=(const ResultsLogReader&);
+  public:
+    ResultsLogReader(const std::string& filename);
+
+    bool Good() const { return good; }
+    //the log's metadata, without any entries
+    DataFormat Metadata() const { return metadata; }
+    //false once every entry has been read
+    bool Next(ResultsLogEntry& entry);
+    void Rewind();
+    //where the entry last returned by Next() lives, for ReadChunk
+    std::streamoff ChunkOffset() const { return chunk_offset; }
+    unsigned int ChunkPosition() const { return position - 1; }
+
+    static bool ReadChunk(std::istream& in, std::streamoff offset, std::vector<ResultsLogEntry>& entries);
+};
+
+//Where every layout's results are in a log, keyed by the layout hash, so that one layout can be looked
+//up without holding the log in memory
+class ResultsLogIndex {
+    typedef std::pair<std::streamoff, unsigned int> location;
+    boost::unordered_multimap<uint64_t, location> locations;
+    std::ifstream file;
+    bool good;
+
+    ResultsLogIndex(const ResultsLogIndex&);
+    ResultsLogIndex& operator=(const ResultsLogIndex&);
+  public:
+    ResultsLogIndex(const std::string& filename);
+
+    bool Good() const { return good; }
+    unsigned int Size() const { return locations.size(); }
+    //every result logged for keyboards equal to k, in the order they were written
+    std::vector<ResultsLogEntry> Lookup(Keyboard& k);
+};
+
+namespace ResultsLog {
+    //writes every result of second after every result of first without loading either, refusing logs
+    //whose word list, input model or distance measure names differ (like DataFormat::operator+)
+    bool Merge(const std::string& first, const std::string& second, const std::string& output);
+    DataFormat ReadDataFormat(const std::string& filename);
+    bool WriteDataFormat(DataFormat& format, const std::string& filename);
+};
+
+#endif
@@ -0,0 +1,35 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef ResultsLog_py_h
+#define ResultsLog_py_h
+
+#include "ResultsLog.h"
+
+#include <vector>
+
+#include <boost/python/list.hpp>
+#include <boost/python/tuple.hpp>
+
+using namespace boost::python;
+
+object ResultsLogPassThrough(object o) { return o; }
+
+//entries come back as (keyboard, efficiency type, result) tuples, like the arguments of AddEntry
+tuple ResultsLogReaderNext(ResultsLogReader& reader) {
+    ResultsLogEntry entry;
+    if(!reader.Next(entry)) {
+        PyErr_SetString(PyExc_StopIteration, "");
+        throw_error_already_set();
+    }
+    return boost::python::make_tuple(entry.keyboard, entry.efficiency, entry.result);
+}
+
+list ResultsLogIndexLookup(ResultsLogIndex& index, Keyboard& k) {
+    std::vector<ResultsLogEntry> entries = index.Lookup(k);
+    list l;
+    for(unsigned int i = 0; i < entries.size(); i++) {
+        l.append(boost::python::make_tuple(entries[i].keyboard, entries[i].efficiency, entries[i].result));
+    }
+    return l;
+}
+
+#endif
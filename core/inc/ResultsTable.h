@@ -0,0 +1,75 @@
+#ifndef ResultsTable_h
+#define ResultsTable_h
+
+#include "DataFormat.h"
+#include "FitnessResult.h"
+#include "Keyboard.h"
+#include "Polygon.h"
+
+#include <string>
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <stdint.h>
+
+//Results stored by column rather than as a list of (keyboard, results) entries, for analysing large
+//numbers of evaluated layouts.  Each distinct layout is stored once as a row of polygon indices (one
+//per character of Characters(), into Polygons()) and every result is a row of (layout, efficiency
+//type, fitness, error, iterations).  Every keyboard added must have the same set of characters.
+//
+//Save writes the columns to a file that can be memory mapped: a header describing each column's name,
+//numpy dtype, shape and offset, followed by the columns themselves, each aligned to 8 bytes.  The
+//python loader is results.LoadColumns.
+class ResultsTable {
+    std::string word_list, input_model, distance_measure;
+    std::string characters;
+    std::vector<Polygon> polygons;
+    std::vector<std::string> types;
+
+    //layouts x characters polygon indices
+    std::vector<uint16_t> layouts;
+    //one entry per result
+    std::vector<uint32_t> layout_column;
+    std::vector<uint8_t> type_column;
+    std::vector<double> fitness_column, error_column;
+    std::vector<uint32_t> iterations_column;
+
+    boost::unordered_multimap<uint64_t, unsigned int> polygon_index, layout_index;
+    int AddLayout(Keyboard& k);
+    int AddType(const std::string& effType);
+
+  public:
+    ResultsTable();
+    ResultsTable(DataFormat& format);
+
+    //false, adding nothing, if k has different characters from the keyboards already added
+    bool Add(Keyboard& k, std::string effType, FitnessResult eff);
+    bool AddDataFormat(DataFormat& format);
+    //streams every entry of a results log into the table
+    bool AddResultsLog(const std::string& filename);
+
+    unsigned int Rows() const { return fitness_column.size(); }
+    unsigned int Layouts() const { return characters.size() > 0 ? layouts.size()/characters.size() : 0; }
+    std::string Characters() const { return characters; }
+    unsigned int Polygons() const { return polygons.size(); }
+    Polygon GetPolygon(unsigned int i) const { return polygons[i]; }
+    unsigned int EfficiencyTypes() const { return types.size(); }
+    std::string EfficiencyType(unsigned int i) const { return types[i]; }
+    //the keyboard stored as layout i
+    Keyboard GetKeyboard(unsigned int i) const;
+
+    std::string GetWordListName() const { return word_list; }
+    std::string GetInputModelName() const { return input_model; }
+    std::string GetDistanceMeasureName() const { return distance_measure; }
+
+    uint16_t* LayoutData() { return layouts.size() > 0 ? &layouts[0] : 0; }
+    uint32_t* LayoutColumn() { return layout_column.size() > 0 ? &layout_column[0] : 0; }
+    uint8_t* TypeColumn() { return type_column.size() > 0 ? &type_column[0] : 0; }
+    double* FitnessColumn() { return fitness_column.size() > 0 ? &fitness_column[0] : 0; }
+    double* ErrorColumn() { return error_column.size() > 0 ? &error_column[0] : 0; }
+    uint32_t* IterationsColumn() { return iterations_column.size() > 0 ? &iterations_column[0] : 0; }
+
+    bool Save(const std::string& filename) const;
+    bool Load(const std::string& filename);
+};
+
+#endif
@@ -0,0 +1,65 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef ResultsTable_py_h
+#define ResultsTable_py_h
+
+#include "ResultsTable.h"
+#include "ArrayView_py.h"
+
+#include <vector>
+
+#include <boost/python/dict.hpp>
+#include <boost/python/list.hpp>
+
+using namespace boost::python;
+
+//read only views of the table's columns.  The table can't be added to or loaded into while any of
+//them are held.
+object ResultsTableLayouts(object self) {
+    ResultsTable& t = extract<ResultsTable&>(self);
+    std::vector<Py_ssize_t> shape(1, t.Layouts());
+    shape.push_back(t.Characters().size());
+    return MakeArrayView(self, &t, t.LayoutData(), "H", sizeof(uint16_t), shape, true);
+}
+
+dict ResultsTableColumns(object self) {
+    ResultsTable& t = extract<ResultsTable&>(self);
+    const std::vector<Py_ssize_t> rows(1, t.Rows());
+    dict columns;
+    columns["layouts"] = ResultsTableLayouts(self);
+    columns["layout"] = MakeArrayView(self, &t, t.LayoutColumn(), "I", sizeof(uint32_t), rows, true);
+    columns["efficiency"] = MakeArrayView(self, &t, t.TypeColumn(), "B", sizeof(uint8_t), rows, true);
+    columns["fitness"] = MakeArrayView(self, &t, t.FitnessColumn(), "d", sizeof(double), rows, true);
+    columns["error"] = MakeArrayView(self, &t, t.ErrorColumn(), "d", sizeof(double), rows, true);
+    columns["iterations"] = MakeArrayView(self, &t, t.IterationsColumn(), "I", sizeof(uint32_t), rows, true);
+    return columns;
+}
+
+bool ResultsTableAdd(ResultsTable& t, Keyboard& k, std::string effType, FitnessResult eff) {
+    CheckNoArrayViews(&t);
+    return t.Add(k, effType, eff);
+}
+
+bool ResultsTableAddDataFormat(ResultsTable& t, DataFormat& format) {
+    CheckNoArrayViews(&t);
+    return t.AddDataFormat(format);
+}
+
+bool ResultsTableAddResultsLog(ResultsTable& t, const std::string& filename) {
+    CheckNoArrayViews(&t);
+    return t.AddResultsLog(filename);
+}
+
+bool ResultsTableLoad(ResultsTable& t, const std::string& filename) {
+    CheckNoArrayViews(&t);
+    return t.Load(filename);
+}
+
+list ResultsTableEfficiencyTypes(ResultsTable& t) {
+    list l;
+    for(unsigned int i = 0; i < t.EfficiencyTypes(); i++) {
+        l.append(t.EfficiencyType(i));
+    }
+    return l;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef SampleSet_h
+#define SampleSet_h
+
+#include "WordList.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "boost/serialization/vector.hpp"
+
+namespace boost {namespace serialization {class access;}}
+
+//A fixed set of pre-drawn samples (word indices plus the standard normal offsets an input model
+//would have drawn for them) that can be replayed against any number of keyboards so that their
+//efficiencies are compared using common random numbers.
+class SampleSet {
+  private:
+    std::vector<unsigned int> indices;
+    std::vector<unsigned int> starts;
+    std::vector<double> offsets;
+    unsigned int list_words;
+    //the Fingerprint() of the list they were drawn from, 0 until they are drawn
+    uint64_t list_fingerprint;
+    bool full_list;
+
+  public:
+    SampleSet();
+    //if samples is 0 then every word in the list is drawn exactly once, in order
+    SampleSet(WordList& words, unsigned int samples, unsigned int seed = 0);
+    void Draw(WordList& words, unsigned int samples, unsigned int seed = 0);
+
+    unsigned int Samples() const { return indices.size(); }
+    unsigned int WordIndex(const unsigned int i) const { return indices[i]; }
+    const double* Offsets(const unsigned int i) const;
+    unsigned int OffsetCount(const unsigned int i) const { return starts[i+1] - starts[i]; }
+    unsigned int ListWords() const { return list_words; }
+    uint64_t ListFingerprint() const { return list_fingerprint; }
+    //false, with an error, unless the samples were drawn from this list (the same words with the same
+    //counts, and so in the same order)
+    bool CheckList(WordList& words) const;
+    bool FullList() const { return full_list; }
+
+    //the draws and the list they came from in the fixed little-endian layout of PackedState.h
+    std::string PackState() const;
+    //returns false and leaves the set as it was if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
+
+  private:
+    friend class boost::serialization::access;
+    template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
+        ar & indices & starts & offsets & list_words & full_list & list_fingerprint;
+    }
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef StandardKeyboards_h
+#define StandardKeyboards_h
+
+#include "Keyboard.h"
+
+//The layouts of keyboards.py built natively, polygon for polygon, so that C++ code (the benchmarks in
+//particular) can start from the same keyboards as the python scripts.  alphabet gives the characters
+//in key order.  The rectangular layouts take as many characters as they're given, up to their number
+//of keys, while the hexagonal and T9 layouts need a character for every key.
+namespace StandardKeyboards {
+    //MakeStandardKeyboard: three staggered rows of 1.0x1.5 keys with 0.2 gaps and one key below
+    Keyboard Qwerty(const char *alphabet = "qwertyuiopasdfghjklzxcvbnm.");
+    //MakeDvorakKeyboard: the same keys in rows of 8, 10 and 9, with the last of 28 keys unused by default
+    Keyboard Dvorak(const char *alphabet = ".pyfgcrlaoeuidhtnsqjkxbmwvz");
+    //MakeHexagonalKeyboard: 27 hexagons of radius scale in rows of 10, 9 and 8
+    Keyboard Hexagonal(const char *alphabet = "qwertyuiopasdfghjklzxcvbnm.", double scale = 0.9);
+    //MakeT9Keyboard: a phone keypad, with three or four characters sharing each key
+    Keyboard T9(const char *alphabet = "abcdefghijklmnopqrstuvwxyz", double scale = 0.9);
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef TaskScheduler_h
+#define TaskScheduler_h
+
+#include <functional>
+
+//Runs a batch of independent tasks of uneven cost on a number of threads, the calling thread being one
+//of them.  The tasks are dealt out as one contiguous run per thread, so that neighbouring tasks (the
+//sample blocks of one keyboard, say) stay together on a thread, which works through its own run from
+//the front.  A thread that runs dry steals the back half of the longest run left, taking a whole
+//neighbourhood of tasks with it rather than scattering them.
+class TaskScheduler {
+    unsigned int threads;
+  public:
+    //0 uses every available core
+    explicit TaskScheduler(unsigned int threads = 0);
+    unsigned int Threads() const { return threads; }
+
+    //calls task(i, thread) once for every i < n and returns when they have all finished.  thread is
+    //below Threads() and no two tasks run on the same one at once, so it can index per-thread state.
+    //If a task throws, no new tasks are started and the first exception is rethrown here.
+    void Run(unsigned int n, const std::function<void(unsigned int task, unsigned int thread)>& task) const;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef Tracing_h
+#define Tracing_h
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+//Spans of time (keyboard evaluations, fitness function calls, batches of their BestMatch calls, WordList
+//rebuilds, and from python the generations of an optimization) recorded while tracing is enabled, and written out in the Chrome
+//trace event format for chrome://tracing or Perfetto.  Every thread records into its own ring buffer
+//that keeps its most recent events, so a long run holds on to its end.  A thread's events are kept
+//after it finishes, and the threads of later batches reuse the row of a finished one.
+namespace Tracing {
+    class Event {
+      public:
+        //names and categories must outlive the trace: string literals, or from Intern
+        const char *name, *category;
+        //nanoseconds since the library was loaded
+        uint64_t start, duration;
+        uint64_t keyboard;
+        double fitness;
+        bool has_keyboard, has_fitness;
+        unsigned int thread;
+    };
+
+    //BestMatch calls to a "BestMatchBatch" span in the Monte Carlo loops
+    const unsigned int bestmatch_batch = 64;
+
+    extern std::atomic<bool> enabled;
+    inline bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+    //starts recording, keeping up to events_per_thread of each thread's latest events
+    void Enable(unsigned int events_per_thread = 65536);
+    void Disable();
+    //drops everything recorded so far
+    void Clear();
+    //a copy of s that lives as long as the process, for names that aren't literals
+    const char* Intern(const std::string& s);
+
+    void Record(Event& event);
+    uint64_t Now();
+    //every thread's events, ordered by start
+    std::vector<Event> Events();
+    std::string ChromeTraceJson();
+    bool Dump(const std::string& path);
+
+    //records the time between construction and destruction, or End, if tracing was enabled when it began
+    class Span {
+        Event event;
+        bool active;
+      public:
+        Span(const char *name, const char *category) : active(Enabled()) {
+            event.name = name;
+            event.category = category;
+            event.has_keyboard = event.has_fitness = false;
+            if(active) event.start = Now();
+        }
+        ~Span() { End(); }
+        void SetKeyboard(uint64_t hash) { event.keyboard = hash; event.has_keyboard = true; }
+        void SetFitness(double fitness) { event.fitness = fitness; event.has_fitness = true; }
+        void End() {
+            if(active) {
+                event.duration = Now() - event.start;
+                Record(event);
+                active = false;
+            }
+        }
+        //ends this span and begins the next with the same name and keyboard, for one span per batch of a loop
+        void Next() {
+            End();
+            active = Enabled();
+            event.has_fitness = false;
+            if(active) event.start = Now();
+        }
+    };
+};
+
+#endif
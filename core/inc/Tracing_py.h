@@ -0,0 +1,46 @@
+//Functions required for the boost-python interface but not necessary for the C++ compilation
+#ifndef Tracing_py_h
+#define Tracing_py_h
+
+#include "Tracing.h"
+#include "Keyboard.h"
+
+#include <string>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/python/object.hpp>
+#include <boost/python/extract.hpp>
+
+using namespace boost::python;
+
+//a span for python code, used as a context manager:
+//    with core.TraceSpan("generation", "optimization") as span:
+//        ...
+//        span.SetFitness(best)
+class TraceSpan {
+    const char *name, *category;
+    boost::scoped_ptr<Tracing::Span> span;
+  public:
+    TraceSpan(const std::string& n, const std::string& c) : name(Tracing::Intern(n)), category(Tracing::Intern(c)) {}
+    void Begin() { span.reset(new Tracing::Span(name, category)); }
+    void End() { if(span) span->End(); }
+    void SetKeyboard(Keyboard& k) { if(span) span->SetKeyboard(k.Hash()); }
+    void SetFitness(double f) { if(span) span->SetFitness(f); }
+};
+
+object TraceSpanEnter(object self) {
+    TraceSpan& span = extract<TraceSpan&>(self);
+    span.Begin();
+    return self;
+}
+
+bool TraceSpanExit(TraceSpan& span, object type, object value, object traceback) {
+    span.End();
+    return false;
+}
+
+void EnableTracing1() {
+    Tracing::Enable();
+}
+
+#endif
@@ -5,10 +5,14 @@
 #include <boost/random/discrete_distribution.hpp>
 #include <boost/unordered_map.hpp>
 
+#include "IngestOptions.h"
+
 #include <string>
+#include <stdint.h>
 #include <vector>
 #include "boost/serialization/vector.hpp"
 #include "boost/serialization/string.hpp"
+#include "boost/serialization/version.hpp"
 
 namespace boost {namespace serialization {class access;}}
 
@@ -38,12 +42,19 @@ class WordList {
     RadixTree *tree;
     bool tree_current;
 
+    uint64_t fingerprint;
+    bool fingerprint_current;
+
     void MarkNotCurrent();
     void UpdateLetters();
     void UpdateVectors();
     void UpdateDistribution();
     void UpdateTree();
     void UpdateAll();
+    std::string PackWords() const;
+    void UnpackWords(const std::string& packed);
+    void RebuildFromVectors();
+    void BuildFromSorted(std::vector< std::pair<std::string, unsigned int> >& sorted);
   public:
     WordList();
     WordList(const WordList& wl);
@@ -51,12 +62,24 @@ class WordList {
     WordList(wordmap wm);
     ~WordList();
     WordList operator+(const WordList& other);
+    //the sum of any number of lists, built in one pass by merging their words in alphabetical order
+    static WordList Merge(const std::vector<const WordList*>& lists, unsigned int threads = 0);
+    //a new list holding only the N most common words
+    WordList TopN(unsigned int N) const;
+    //a synthetic list of distinct random words whose occurances fall off as top_occurances/rank^exponent,
+    //with english letter frequencies and word lengths so that layouts are exercised realistically
+    static WordList Zipfian(unsigned int words, double exponent = 1.0, unsigned int seed = 0, unsigned int top_occurances = 1000000);
 
     void SetWordMap(wordmap wm);
     wordmap GetWordMap() { return words; }
 
     unsigned int AddWord(const char *word, const unsigned int occurances = 1);
+    //adds every token of the files, cleaned according to options, returning how many were added.  The
+    //files are memory mapped and split between threads that count separately before merging.
+    unsigned int IngestFiles(const std::vector<std::string>& paths, const IngestOptions& options = IngestOptions());
     unsigned int Occurances(const char *word);
+    //the list's own copy of word, which lives as long as the word stays in the list, or 0 if it isn't one
+    const char* Find(const char *word) const;
     unsigned int TotalOccurances() { return total; }
     const char* Word(const unsigned int index);
     unsigned int Occurances(const unsigned int index);
@@ -67,28 +90,49 @@ class WordList {
     unsigned int MaxN() { return MAXN; }
     int WordIndex(const char* word);
     const char* RandomWord();
+    //from the caller's generator, which leaves the list's own alone
+    const char* RandomWord(boost::mt19937& generator);
 
     unsigned int TotalLetterOccurances();
     unsigned int LetterOccurances(const char c);
     void SetSeed(unsigned int s) { generator.seed(s); }
+    //builds every derived structure up front so later reads don't have to
+    void Prepare();
+    //for estimators that sample the list with their own distributions but should follow SetSeed()
+    boost::mt19937& Generator() { return generator; }
     void Reset();
+    //identifies the list's contents regardless of how or in what order it was built
+    uint64_t Fingerprint();
 
     RadixTree *GetTree() { UpdateTree(); return tree; }
 
+    //the words and their occurances in a fixed little-endian layout that any platform can read back: an
+    //8 byte magic, a uint32 version, a uint32 word count, the occurances as uint32s, then a uint64 length
+    //and the words as one nul separated block, in the list's sorted order
+    std::string PackState();
+    //returns false and leaves the list as it was if data isn't a state PackState wrote
+    bool UnpackState(const char* data, size_t size);
+
   private:
     friend class boost::serialization::access;
     template<typename Archive> void serialize(Archive& ar, const unsigned int version) {
         //boost doesn't support serialization of unordered_maps so we'll store the vectors
-        UpdateVectors();
-        ar & occurance_vector & word_vector;
-        //and we'll rebuild the hash map if it doesn't already exist
-        if(words.size() == 0) {
-            for(unsigned int i = 0; i < word_vector.size(); i++) {
-                AddWord(word_vector[i].c_str(), occurance_vector[i]);
-            }
-            tree_current = false;
+        if(Archive::is_saving::value) UpdateVectors();
+        if(version == 0) {
+            ar & occurance_vector & word_vector;
         }
+        else {
+            //the words go out as one nul separated block, which is much smaller and faster than a vector of strings
+            std::string packed;
+            if(Archive::is_saving::value) packed = PackWords();
+            ar & packed & occurance_vector;
+            if(Archive::is_loading::value) UnpackWords(packed);
+        }
+        //and we'll rebuild the hash map from the vectors, which are already in order
+        if(Archive::is_loading::value) RebuildFromVectors();
     }
 };
 
+BOOST_CLASS_VERSION(WordList, 1)
+
 #endif
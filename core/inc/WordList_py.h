@@ -3,6 +3,7 @@
 #define WordList_py_h
 
 #include "WordList.h"
+#include "FrozenWordList.h"
 #include "RadixTree_py.h"
 
 //bost include files
@@ -20,8 +21,12 @@ typedef boost::unordered_map<std::string, unsigned int> wordmap;
 
 
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(AddWord_overloads, AddWord, 1, 2)
+BOOST_PYTHON_FUNCTION_OVERLOADS(Zipfian_overloads, WordList::Zipfian, 1, 4)
 unsigned int (WordList::*Occurances1)(const char*) = &WordList::Occurances;
 unsigned int (WordList::*Occurances2)(const unsigned int) = &WordList::Occurances;
+const char* (WordList::*RandomWord1)() = &WordList::RandomWord;
+unsigned int (FrozenWordList::*FrozenOccurances1)(const char*) const = &FrozenWordList::Occurances;
+unsigned int (FrozenWordList::*FrozenOccurances2)(const unsigned int) const = &FrozenWordList::Occurances;
 
 dict WordListMapDict(WordList& wl) {
     dict d;
@@ -43,9 +48,39 @@ void SetWordListMapDict(WordList& wl, dict d) {
     }
 }
 
+//paths can be any python sequence of file names
+unsigned int WordListIngestFiles(WordList& wl, object paths, const IngestOptions& options) {
+    std::vector<std::string> files;
+    for(unsigned int i = 0; i < len(paths); i++) {
+        files.push_back(extract<std::string>(paths[i]));
+    }
+    return wl.IngestFiles(files, options);
+}
+
+unsigned int WordListIngestFiles1(WordList& wl, object paths) {
+    return WordListIngestFiles(wl, paths, IngestOptions());
+}
+
+//lists can be any python sequence of word lists
+WordList MergeWordLists(object lists, unsigned int threads) {
+    std::vector<const WordList*> l;
+    for(unsigned int i = 0; i < len(lists); i++) {
+        l.push_back(&extract<WordList&>(lists[i])());
+    }
+    return WordList::Merge(l, threads);
+}
+
+WordList MergeWordLists1(object lists) {
+    return MergeWordLists(lists, 0);
+}
+
 list WordListTreeMatches(WordList& wl, const char* stringform) {
     return RadixTreeMatches( *wl.GetTree(), stringform);
 }
 
+list FrozenWordListTreeMatches(const FrozenWordList& wl, const char* stringform) {
+    return RadixTreeMatches( *wl.GetTree(), stringform);
+}
+
 
 #endif
@@ -0,0 +1,27 @@
+#ifndef WorkerModels_h
+#define WorkerModels_h
+
+#include <boost/noncopyable.hpp>
+
+#include "InputModels/InputModel.h"
+
+#include <vector>
+
+//The models a batch of threads evaluates with: the model itself if it's Shareable, or failing that a
+//Shareable clone of it, serves every worker; otherwise each worker takes its own clone.  Everything is
+//cloned in the constructor, since Clone() may need the caller's thread, and the clones are deleted
+//along with this, however the batch ends.
+class WorkerModels : private boost::noncopyable {
+    const InputModel *shared;
+    std::vector<InputModel*> clones;
+    unsigned int workers;
+  public:
+    WorkerModels(InputModel& model, unsigned int threads);
+    ~WorkerModels();
+
+    //below 2 when the model can't be spread over threads and should be used on the caller's thread
+    unsigned int Workers() const { return workers; }
+    const InputModel& Model(unsigned int worker) const { return shared != 0 ? *shared : *clones[worker]; }
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "ConfusionMatrix.h"
+
+#include <algorithm>
+#include "math.h"
+
+using namespace std;
+
+namespace {
+    //largest share first, then by target and decoded word so ties come out the same every time
+    bool LargerShare(const Confusion& a, const Confusion& b) {
+        if(a.share != b.share) return a.share > b.share;
+        if(a.target != b.target) return a.target < b.target;
+        return a.decoded < b.decoded;
+    }
+};
+
+Confusion::Confusion() {
+    target = decoded = count = samples = 0;
+    rate = rate_error = share = share_error = 0;
+}
+
+ConfusionMatrix::ConfusionMatrix(unsigned int w) {
+    words = w;
+    offsets.push_back(0);
+}
+
+void ConfusionMatrix::AddRow(unsigned int s, double weight, const vector<uint32_t>& c, const vector<uint32_t>& n) {
+    columns.insert(columns.end(), c.begin(), c.end());
+    counts.insert(counts.end(), n.begin(), n.end());
+    offsets.push_back(columns.size());
+    samples.push_back(s);
+    weights.push_back(weight);
+}
+
+unsigned int ConfusionMatrix::Samples(unsigned int target) const {
+    return target < samples.size() ? samples[target] : 0;
+}
+
+double ConfusionMatrix::Weight(unsigned int target) const {
+    return target < weights.size() ? weights[target] : 0;
+}
+
+unsigned int ConfusionMatrix::Count(unsigned int target, unsigned int decoded) const {
+    if(target >= samples.size()) return 0;
+    const vector<uint32_t>::const_iterator begin = columns.begin() + offsets[target], end = columns.begin() + offsets[target + 1];
+    const vector<uint32_t>::const_iterator found = lower_bound(begin, end, decoded);
+    return found != end && *found == decoded ? counts[found - columns.begin()] : 0;
+}
+
+Confusion ConfusionMatrix::Entry(unsigned int target, unsigned int decoded) const {
+    Confusion c;
+    c.target = target;
+    c.decoded = decoded;
+    c.count = Count(target, decoded);
+    c.samples = Samples(target);
+    if(c.samples == 0) return c;
+    c.rate = double(c.count)/double(c.samples);
+    c.rate_error = sqrt(c.rate*(1.0 - c.rate)/double(c.samples));
+    c.share = weights[target]*c.rate;
+    c.share_error = weights[target]*c.rate_error;
+    return c;
+}
+
+vector<Confusion> ConfusionMatrix::TopConfusions(unsigned int n) const {
+    vector<Confusion> confusions;
+    for(unsigned int t = 0; t < samples.size(); t++) {
+        for(unsigned int e = offsets[t]; e < offsets[t + 1]; e++) {
+            if(columns[e] != t) confusions.push_back(Entry(t, columns[e]));
+        }
+    }
+    n = min(n, (unsigned int) confusions.size());
+    partial_sort(confusions.begin(), confusions.begin() + n, confusions.end(), LargerShare);
+    confusions.resize(n);
+    return confusions;
+}
+
+FitnessResult ConfusionMatrix::Efficiency() const {
+    double total = 0, fitness = 0, variance = 0;
+    unsigned int iterations = 0;
+    for(unsigned int t = 0; t < samples.size(); t++) {
+        if(samples[t] == 0) continue;
+        const Confusion c = Entry(t, t);
+        total += weights[t];
+        fitness += c.share;
+        variance += c.share_error*c.share_error;
+        iterations += samples[t];
+    }
+    if(total <= 0) return FitnessResult(iterations, 0, 0);
+    return FitnessResult(iterations, fitness/total, sqrt(variance)/total);
+}
@@ -1,8 +1,14 @@
 #include "DataFormat.h"
+#include "PackedState.h"
 
 #include <iostream>
 using namespace std;
 
+namespace {
+    const char state_magic[8] = "DODODAT";
+    const uint32_t state_version = 1;
+}
+
 DataFormat::DataFormat() {
 }
 
@@ -21,6 +27,7 @@ DataFormat::DataFormat(DataFormat const& td) {
         }
         result_vector.push_back(make_pair(k, effPair));
     }
+    RebuildIndex();
 }
 
 DataFormat::DataFormat(WordList& wl, string wln, string im, string dm) {
@@ -38,11 +45,10 @@ void DataFormat::AddEntry(Keyboard k, string effType, FitnessResult eff, int ind
     //If no entry matches the current keyboard then create a new entry
     if(index<0) {
         //check to see if any efficiencies for this keyboard layout have been entered yet
-        for(unsigned int i = 0; i != result_vector.size(); i++) {
-            if(result_vector[i].first == k) {
-                result_vector[i].second.push_back(make_pair(effType, eff));
-                return;
-            }        
+        const int existing = FindEntry(k);
+        if(existing >= 0) {
+            result_vector[existing].second.push_back(make_pair(effType, eff));
+            return;
         }
     }
 
@@ -78,11 +84,32 @@ void DataFormat::AddEntry(Keyboard k, string effType, FitnessResult eff, int ind
     
     vector<pair<string, FitnessResult> > effPair;
     effPair.push_back(make_pair(effType, eff));
+    layout_index.insert(make_pair(k.Hash(), (unsigned int) result_vector.size()));
     result_vector.push_back(make_pair(k, effPair));
 
     return;
 }
 
+int DataFormat::FindEntry(Keyboard& k) {
+    typedef boost::unordered_multimap<uint64_t, unsigned int>::iterator index_iterator;
+    pair<index_iterator, index_iterator> range = layout_index.equal_range(k.Hash());
+    //the first match, to stay consistent with the order entries were added in
+    int found = -1;
+    for(index_iterator it = range.first; it != range.second; it++) {
+        if((found < 0 || it->second < (unsigned int) found) && result_vector[it->second].first == k) {
+            found = it->second;
+        }
+    }
+    return found;
+}
+
+void DataFormat::RebuildIndex() {
+    layout_index.clear();
+    for(unsigned int i = 0; i != result_vector.size(); i++) {
+        layout_index.insert(make_pair(result_vector[i].first.Hash(), i));
+    }
+}
+
 DataFormat::resultEntry DataFormat::GetEntry(const unsigned int index) const {
     if(index > result_vector.size()) {
         cerr << "ERROR: Index of result_vector is out of range" << endl;
@@ -152,4 +179,60 @@ bool DataFormat::operator==(const DataFormat& other) {
     return true;
 }
 
+string DataFormat::PackState() {
+    StateWriter state(state_magic, state_version);
+    state.PutString(w.PackState());
+    state.PutString(word_list);
+    state.PutString(input_model);
+    state.PutString(distance_measure);
+    state.PutU32(result_vector.size());
+    for(unsigned int i = 0; i < result_vector.size(); i++) {
+        state.PutString(result_vector[i].first.PackState());
+        state.PutU32(result_vector[i].second.size());
+        for(unsigned int j = 0; j < result_vector[i].second.size(); j++) {
+            state.PutString(result_vector[i].second[j].first);
+            state.PutString(result_vector[i].second[j].second.PackState());
+        }
+    }
+    return state.State();
+}
 
+bool DataFormat::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    const char *bytes = 0;
+    size_t n = 0;
+    WordList read_words;
+    string read_word_list, read_input_model, read_distance_measure;
+    uint32_t entries = 0;
+    if(!state.GetBytes(bytes, n) || !read_words.UnpackState(bytes, n) || !state.GetString(read_word_list)
+            || !state.GetString(read_input_model) || !state.GetString(read_distance_measure)
+            || !state.GetU32(entries) || !state.Fits(entries, 12)) {
+        return false;
+    }
+
+    vector<resultEntry> read_results(entries);
+    for(unsigned int i = 0; i < entries; i++) {
+        uint32_t results = 0;
+        if(!state.GetBytes(bytes, n) || !read_results[i].first.UnpackState(bytes, n) || !state.GetU32(results) || !state.Fits(results, 16)) {
+            return false;
+        }
+        read_results[i].second.resize(results);
+        for(unsigned int j = 0; j < results; j++) {
+            if(!state.GetString(read_results[i].second[j].first) || !state.GetBytes(bytes, n)
+                    || !read_results[i].second[j].second.UnpackState(bytes, n)) {
+                return false;
+            }
+        }
+    }
+    if(!state.Finished()) {
+        return false;
+    }
+
+    w = read_words;
+    word_list = read_word_list;
+    input_model = read_input_model;
+    distance_measure = read_distance_measure;
+    result_vector.swap(read_results);
+    RebuildIndex();
+    return true;
+}
@@ -0,0 +1,91 @@
+#include "FitnessCache.h"
+#include "Hashing.h"
+
+using namespace std;
+
+FitnessCache::FitnessCache(unsigned int capacity) : capacity(capacity) {
+    hits = 0;
+    misses = 0;
+}
+
+FitnessResult FitnessCache::Add(uint64_t key, FitnessResult result) {
+    lock_guard<mutex> guard(lock);
+    entrymap::iterator it = index.find(key);
+    if(it != index.end()) {
+        FitnessResult& cached = it->second->second;
+        //results with no iterations are exact (or unweighted) so there's nothing to combine
+        if(cached.Iterations() > 0 && result.Iterations() > 0) {
+            result = cached + result;
+        }
+        entries.erase(it->second);
+        index.erase(it);
+    }
+
+    entries.push_front(make_pair(key, result));
+    index[key] = entries.begin();
+    while(entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    return result;
+}
+
+bool FitnessCache::Lookup(uint64_t key, FitnessResult& result) {
+    lock_guard<mutex> guard(lock);
+    entrymap::iterator it = index.find(key);
+    if(it == index.end()) {
+        misses++;
+        return false;
+    }
+    hits++;
+    //move it to the front of the eviction order
+    entries.splice(entries.begin(), entries, it->second);
+    result = it->second->second;
+    return true;
+}
+
+unsigned int FitnessCache::Size() {
+    lock_guard<mutex> guard(lock);
+    return entries.size();
+}
+
+void FitnessCache::SetCapacity(unsigned int c) {
+    lock_guard<mutex> guard(lock);
+    capacity = c;
+    while(entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+void FitnessCache::Clear() {
+    lock_guard<mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    hits = 0;
+    misses = 0;
+}
+
+uint64_t FitnessCache::Key(Keyboard& keyboard, uint64_t context) {
+    return HashCombine(keyboard.Hash(), context);
+}
+
+uint64_t FitnessCache::Context(WordList& words, const InputModel& model, EvaluationOptions& options) {
+    uint64_t h = HashCombine(words.Fingerprint(), model.Fingerprint());
+    h = HashCombine(h, options.efficiency);
+    switch(options.efficiency) {
+        case EvaluationOptions::Fast:
+            h = HashCombine(h, HashDouble(options.exp_par));
+            h = HashCombine(h, options.precision);
+            h = HashCombine(h, HashDouble(options.epsilon));
+            break;
+        case EvaluationOptions::RadixMonteCarlo:
+            h = HashCombine(h, options.possibility_tries);
+            break;
+        default:
+            //the whole list once through is an exact score, not a sample to be combined with others
+            if(options.iterations == 0) h = HashCombine(h, HashString("full list"));
+            break;
+    }
+    return h;
+}
@@ -0,0 +1,86 @@
+#include "FitnessFunctions.h"
+#include "Hashing.h"
+#include "TaskScheduler.h"
+#include "Tracing.h"
+#include "WorkerModels.h"
+#include "InputModels/InputVector.h"
+
+#include <algorithm>
+#include <thread>
+using namespace std;
+
+namespace {
+    //one target's decodings, run length encoded by word index
+    class ConfusionRow {
+      public:
+        vector<uint32_t> columns, counts;
+    };
+
+    //decodes samples noisy vectors of the target against words, with noise of its own so the row
+    //doesn't depend on which thread ran it.  index (the same list, frozen) turns the matches back into
+    //word indices.
+    template<typename Words> void DecodeTarget(Keyboard& keyboard, const InputModel& model, Words& words, const FrozenWordList& index,
+            unsigned int target, unsigned int samples, unsigned int seed, ConfusionRow& row) {
+        boost::mt19937 noise(seed);
+        const char *word = index.Word(target);
+        vector<uint32_t> decoded;
+        decoded.reserve(samples);
+        for(unsigned int s = 0; s < samples; s++) {
+            InputVector sigma = model.RandomVector(word, keyboard, noise);
+            const char *best_word = model.BestMatch(sigma, keyboard, words);
+            const int d = best_word != 0 ? index.WordIndex(best_word) : -1;
+            if(d >= 0) decoded.push_back(d);
+        }
+
+        sort(decoded.begin(), decoded.end());
+        for(unsigned int i = 0; i < decoded.size(); i++) {
+            if(row.columns.empty() || row.columns.back() != decoded[i]) {
+                row.columns.push_back(decoded[i]);
+                row.counts.push_back(0);
+            }
+            row.counts.back()++;
+        }
+    }
+}
+
+//The Monte Carlo of MonteCarloEfficiency stratified by word: every target gets the same number of
+//samples, each seeded from seed and its index, and is weighted by its occurrences afterwards.  The
+//targets are shared out between threads and the models are shared or cloned through WorkerModels,
+//so the matrix only depends on the seed.
+ConfusionMatrix FitnessFunctions::Confusions(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int samples, unsigned int targets,
+        unsigned int threads, unsigned int seed) {
+    Tracing::Span span("Confusions", "fitness");
+    span.SetKeyboard(keyboard.Hash());
+    words.Prepare();
+    if(targets == 0 || targets > words.Words()) {
+        targets = words.Words();
+    }
+
+    Tracing::Span freeze_span("FreezeWordList", "wordlist");
+    const FrozenWordList frozen(words);
+    freeze_span.End();
+
+    unsigned int nthreads = threads > 0 ? threads : thread::hardware_concurrency();
+    nthreads = min(max(nthreads, 1u), max(targets, 1u));
+
+    const WorkerModels workers(model, nthreads);
+
+    vector<ConfusionRow> rows(targets);
+    if(workers.Workers() < 2) {
+        for(unsigned int t = 0; t < targets; t++) {
+            DecodeTarget(keyboard, model, words, frozen, t, samples, (unsigned int) HashCombine(HashMix(seed), t), rows[t]);
+        }
+    }
+    else {
+        TaskScheduler(workers.Workers()).Run(targets, [&](unsigned int t, unsigned int worker) {
+            DecodeTarget(keyboard, workers.Model(worker), frozen, frozen, t, samples, (unsigned int) HashCombine(HashMix(seed), t), rows[t]);
+        });
+    }
+
+    ConfusionMatrix matrix(words.Words());
+    const double total = frozen.TotalOccurances();
+    for(unsigned int t = 0; t < targets; t++) {
+        matrix.AddRow(samples, total > 0 ? frozen.Occurances(t)/total : 0, rows[t].columns, rows[t].counts);
+    }
+    return matrix;
+}
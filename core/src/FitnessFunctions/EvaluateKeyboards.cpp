@@ -0,0 +1,148 @@
+#include "FitnessFunctions.h"
+#include "FitnessCache.h"
+#include "Hashing.h"
+#include "TaskScheduler.h"
+#include "Tracing.h"
+#include "WorkerModels.h"
+
+#include <thread>
+using namespace std;
+
+namespace {
+    //a block of one keyboard's samples
+    class EvaluationTask {
+      public:
+        unsigned int keyboard, iterations, seed;
+        EvaluationTask(unsigned int k, unsigned int i, unsigned int s) : keyboard(k), iterations(i), seed(s) {}
+    };
+
+    //generators of its own, seeded as SetSeed would seed the list and the model, so a keyboard scores the
+    //same on either path and the caller's generators are left alone
+    FitnessResult Evaluate(Keyboard& keyboard, InputModel& model, WordList& words, EvaluationOptions& options, unsigned int seed, unsigned int iterations) {
+        boost::mt19937 word_generator(seed), noise_generator(seed);
+        switch(options.efficiency) {
+            case EvaluationOptions::Fast:
+                if(options.epsilon > 0) return FitnessFunctions::TruncatedFastEfficiency(keyboard, model, words, options.exp_par, options.epsilon);
+                return FitnessFunctions::FastEfficiency(keyboard, model, words, options.exp_par, options.precision);
+            case EvaluationOptions::RadixMonteCarlo:
+                return FitnessFunctions::RadixMonteCarloEfficiency(keyboard, model, words, iterations, options.possibility_tries, word_generator, noise_generator);
+            default:
+                return FitnessFunctions::MonteCarloEfficiency(keyboard, model, words, iterations, word_generator, noise_generator);
+        }
+    }
+
+    FitnessResult Evaluate(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, EvaluationOptions& options, unsigned int seed, unsigned int iterations) {
+        boost::mt19937 word_generator(seed), noise_generator(seed);
+        switch(options.efficiency) {
+            case EvaluationOptions::Fast:
+                if(options.epsilon > 0) return FitnessFunctions::TruncatedFastEfficiency(keyboard, model, words, options.exp_par, options.epsilon);
+                return FitnessFunctions::FastEfficiency(keyboard, model, words, options.exp_par, options.precision);
+            case EvaluationOptions::RadixMonteCarlo:
+                return FitnessFunctions::RadixMonteCarloEfficiency(keyboard, model, words, iterations, options.possibility_tries, word_generator, noise_generator);
+            default:
+                return FitnessFunctions::MonteCarloEfficiency(keyboard, model, words, iterations, word_generator, noise_generator);
+        }
+    }
+
+    template<typename Model, typename Words> FitnessResult EvaluateKeyboard(Keyboard& keyboard, Model& model, Words& words, EvaluationOptions& options, unsigned int seed, unsigned int iterations) {
+        Tracing::Span span("EvaluateKeyboard", "evaluation");
+        span.SetKeyboard(keyboard.Hash());
+        FitnessResult result = Evaluate(keyboard, model, words, options, seed, iterations);
+        span.SetFitness(result.Fitness());
+        return result;
+    }
+}
+
+//Scores a whole population with one call.  With options.block set, the Monte Carlo estimates are split
+//into tasks of that many samples, each seeded on its own, which a TaskScheduler balances across the
+//threads however uneven they are; otherwise each keyboard is one task.  The workers share a single
+//FrozenWordList, built once up front with the sorted words, the distribution and the radix tree, and
+//draw their noise from generators of their own, with the model shared or cloned through WorkerModels.
+//Models that can't be cloned are evaluated on this thread, against the list itself.  Either way the
+//results only depend on the seed and the block size.
+//With a cache, layouts that already have enough iterations aren't evaluated at all and the rest are
+//only topped up to options.iterations.
+vector<FitnessResult> FitnessFunctions::EvaluateKeyboards(vector<Keyboard>& keyboards, InputModel& model, WordList& words, EvaluationOptions& options, FitnessCache* cache, uint64_t context) {
+    Tracing::Span span("EvaluateKeyboards", "evaluation");
+    vector<FitnessResult> results(keyboards.size());
+
+    vector<unsigned int> pending, seeds(keyboards.size()), iterations(keyboards.size(), options.iterations);
+    vector<uint64_t> keys(keyboards.size());
+    for(unsigned int i = 0; i < keyboards.size(); i++) {
+        seeds[i] = options.seed + i;
+        FitnessResult cached;
+        if(cache != 0) {
+            keys[i] = FitnessCache::Key(keyboards[i], context);
+            if(cache->Lookup(keys[i], cached)) {
+                if(options.efficiency == EvaluationOptions::Fast || options.iterations == 0 || cached.Iterations() == 0
+                        || (unsigned int) cached.Iterations() >= options.iterations) {
+                    results[i] = cached;
+                    continue;
+                }
+                iterations[i] = options.iterations - cached.Iterations();
+                //seeded from the layout and how far along it is, so the top up neither replays the samples
+                //already in the cache nor shares a seed with another keyboard's evaluation
+                seeds[i] = (unsigned int) HashCombine(keys[i], cached.Iterations());
+            }
+        }
+        pending.push_back(i);
+    }
+
+    //the first block keeps the keyboard's seed, so a single block gives what an unsplit evaluation would
+    vector<EvaluationTask> tasks;
+    vector<unsigned int> first_task(pending.size() + 1);
+    for(unsigned int p = 0; p < pending.size(); p++) {
+        const unsigned int i = pending[p];
+        first_task[p] = tasks.size();
+        const bool split = options.block > 0 && options.efficiency != EvaluationOptions::Fast && iterations[i] > options.block;
+        if(!split) {
+            tasks.push_back(EvaluationTask(i, iterations[i], seeds[i]));
+            continue;
+        }
+        for(unsigned int b = 0, done = 0; done < iterations[i]; b++, done += options.block) {
+            const unsigned int seed = b == 0 ? seeds[i] : (unsigned int) HashCombine(HashMix(seeds[i]), b);
+            tasks.push_back(EvaluationTask(i, min(options.block, iterations[i] - done), seed));
+        }
+    }
+    first_task[pending.size()] = tasks.size();
+
+    unsigned int nthreads = options.threads > 0 ? options.threads : thread::hardware_concurrency();
+    nthreads = min(max(nthreads, 1u), (unsigned int) tasks.size());
+
+    const WorkerModels workers(model, nthreads);
+
+    vector<FitnessResult> partial(tasks.size());
+    if(workers.Workers() < 2) {
+        words.Prepare();
+        for(unsigned int k = 0; k < tasks.size(); k++) {
+            const EvaluationTask& task = tasks[k];
+            partial[k] = EvaluateKeyboard(keyboards[task.keyboard], model, words, options, task.seed, task.iterations);
+        }
+    }
+    else {
+        Tracing::Span freeze_span("FreezeWordList", "wordlist");
+        const FrozenWordList frozen(words);
+        freeze_span.End();
+        TaskScheduler(workers.Workers()).Run(tasks.size(), [&](unsigned int k, unsigned int t) {
+            const EvaluationTask& task = tasks[k];
+            partial[k] = EvaluateKeyboard(keyboards[task.keyboard], workers.Model(t), frozen, options, task.seed, task.iterations);
+        });
+    }
+
+    //the blocks are added up in order so the results don't depend on the thread timing
+    for(unsigned int p = 0; p < pending.size(); p++) {
+        FitnessResult& result = results[pending[p]];
+        result = partial[first_task[p]];
+        for(unsigned int k = first_task[p] + 1; k < first_task[p + 1]; k++) {
+            result = result + partial[k];
+        }
+    }
+
+    if(cache != 0) {
+        for(unsigned int p = 0; p < pending.size(); p++) {
+            const unsigned int i = pending[p];
+            results[i] = cache->Add(keys[i], results[i]);
+        }
+    }
+    return results;
+}
@@ -1,31 +1,148 @@
 #include "FitnessFunctions.h"
+#include "Instrumentation.h"
+#include "Tracing.h"
 #include "InputModels/InputVector.h"
+#include "PerfectVectorIndex.h"
 
 #include "string.h"
 #include "math.h"
 
-inline double pairwise_efficiency(InputModel& model, InputVector& iv1, InputVector& iv2, const double exp_par) {
-    return 1.0-0.5*exp(-exp_par*model.VectorDistance(iv1, iv2));
-}
+#include <vector>
 
-FitnessResult FitnessFunctions::FastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par) {
-    //cache the perfect vectors first
-    InputVector *perfect = new InputVector [words.Words()];
-    for(unsigned int i = 0; i < words.Words(); i++) {
-        perfect[i] = model.PerfectVector(words.Word(i), keyboard);
+namespace {
+    template<typename Words> FitnessResult PairwiseEfficiency(Keyboard& keyboard, const InputModel& model, Words& words, double exp_par) {
+        const Instrumentation::Scope scope;
+        Tracing::Span span("FastEfficiency", "fitness");
+        span.SetKeyboard(keyboard.Hash());
+        //cache the perfect vectors first
+        InputVector *perfect = new InputVector [words.Words()];
+        for(unsigned int i = 0; i < words.Words(); i++) {
+            perfect[i] = model.PerfectVector(words.Word(i), keyboard);
+        }
+
+        double totalocc = 0, totaleff = 0;
+        //cycle over all pairs of words, one batch of distances per row
+        std::vector<double> distances(words.Words());
+        for(unsigned int i = 0; i < words.Words(); i++) {
+            model.VectorDistanceBatch(perfect[i], perfect, words.Words(), &distances[0]);
+            double singleeff = 1;
+            for(unsigned int j = 0; j < words.Words(); j++) {
+                singleeff *= 1.0-0.5*exp(-exp_par*distances[j]); //these are being calculate twice, could optimize
+            }
+            totaleff += singleeff*double(words.Occurances(i));
+            totalocc += words.Occurances(i);
+        }
+
+        delete [] perfect;
+        span.SetFitness(totaleff/totalocc);
+        return scope.Attach(FitnessResult(0, totaleff/totalocc, 0));
+    }
+
+    template<typename Words> FitnessResult PairwiseEfficiency(Keyboard& keyboard, const InputModel& model, Words& words, double exp_par, PerfectVectorStore::Precision precision) {
+        const Instrumentation::Scope scope;
+        if(precision == PerfectVectorStore::Double || !model.EuclideanDistance()) {
+            return PairwiseEfficiency(keyboard, model, words, exp_par);
+        }
+        Tracing::Span span("FastEfficiency", "fitness");
+        span.SetKeyboard(keyboard.Hash());
+
+        std::vector<InputVector> perfect(words.Words());
+        for(unsigned int i = 0; i < words.Words(); i++) {
+            perfect[i] = model.PerfectVector(words.Word(i), keyboard);
+        }
+        PerfectVectorStore store(precision);
+        if(perfect.size() == 0 || !store.Build(&perfect[0], perfect.size())) {
+            return PairwiseEfficiency(keyboard, model, words, exp_par);
+        }
+
+        double totalocc = 0, totaleff = 0;
+        std::vector<double> distances(words.Words());
+        for(unsigned int i = 0; i < words.Words(); i++) {
+            store.Distances(perfect[i], &distances[0], model.MaxDistance());
+            double singleeff = 1;
+            for(unsigned int j = 0; j < words.Words(); j++) {
+                singleeff *= 1.0-0.5*exp(-exp_par*distances[j]);
+            }
+            totaleff += singleeff*double(words.Occurances(i));
+            totalocc += words.Occurances(i);
+        }
+        span.SetFitness(totaleff/totalocc);
+        return scope.Attach(FitnessResult(0, totaleff/totalocc, 0));
     }
 
-    double totalocc = 0, totaleff = 0;
-    //cycle over all pairs of words
-    for(unsigned int i = 0; i < words.Words(); i++) {
-        double singleeff = 1;
-        for(unsigned int j = 0; j < words.Words(); j++) {
-            singleeff *= pairwise_efficiency(model, perfect[i], perfect[j], exp_par); //these are being calculate twice, could optimize
+    //epsilon is a tolerance on the fitness, so with N words only the pairs closer than
+    //-log(epsilon/N)/exp_par, where a term can still fall below 1 - epsilon/2N, are looked at.  The
+    //N - k pairs further apart multiply a word's efficiency by at least (1 - epsilon/2N)^(N - k), which
+    //is within epsilon/2 of 1 however many words there are.  The exact fitness lies between
+    //fitness - truncation and fitness.
+    template<typename Words> FitnessResult TruncatedPairwiseEfficiency(Keyboard& keyboard, const InputModel& model, Words& words, double exp_par, double epsilon) {
+        const Instrumentation::Scope scope;
+        if(epsilon <= 0 || epsilon >= 1 || exp_par <= 0 || !model.EuclideanDistance()) {
+            return PairwiseEfficiency(keyboard, model, words, exp_par);
+        }
+        Tracing::Span span("TruncatedFastEfficiency", "fitness");
+        span.SetKeyboard(keyboard.Hash());
+
+        std::vector<InputVector> perfect(words.Words());
+        for(unsigned int i = 0; i < words.Words(); i++) {
+            perfect[i] = model.PerfectVector(words.Word(i), keyboard);
         }
-        totaleff += singleeff*double(words.Occurances(i));
-        totalocc += words.Occurances(i);
+        PerfectVectorIndex index;
+        if(perfect.size() == 0 || !index.Build(&perfect[0], perfect.size())) {
+            return PairwiseEfficiency(keyboard, model, words, exp_par);
+        }
+
+        //a model that caps its distances below the radius puts every pair beyond the cap at exactly the
+        //cap, so those are accounted for exactly and nothing is neglected
+        const double pair_epsilon = epsilon/double(words.Words());
+        const double maxd = model.MaxDistance();
+        const double cutoff = -log(pair_epsilon)/exp_par;
+        const bool capped = maxd > 0 && maxd < cutoff;
+        const double radius = capped ? maxd : cutoff;
+        const double beyond = capped ? 1.0-0.5*exp(-exp_par*maxd) : 1.0-0.5*pair_epsilon;
+
+        double totalocc = 0, totaleff = 0, neglected = 0;
+        std::vector<unsigned int> neighbours;
+        std::vector<double> distances;
+        for(unsigned int i = 0; i < words.Words(); i++) {
+            index.Within(i, radius, neighbours, distances);
+            double singleeff = 1;
+            for(unsigned int j = 0; j < distances.size(); j++) {
+                singleeff *= 1.0-0.5*exp(-exp_par*distances[j]);
+            }
+            const double far = pow(beyond, double(words.Words() - neighbours.size()));
+            if(capped) singleeff *= far;
+            else neglected += singleeff*(1.0 - far)*double(words.Occurances(i));
+            totaleff += singleeff*double(words.Occurances(i));
+            totalocc += words.Occurances(i);
+        }
+        span.SetFitness(totaleff/totalocc);
+        FitnessResult result(0, totaleff/totalocc, 0);
+        result.SetTruncation(neglected/totalocc);
+        return scope.Attach(result);
     }
+}
+
+FitnessResult FitnessFunctions::FastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par) {
+    return PairwiseEfficiency(keyboard, model, words, exp_par);
+}
+
+FitnessResult FitnessFunctions::FastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par, PerfectVectorStore::Precision precision) {
+    return PairwiseEfficiency(keyboard, model, words, exp_par, precision);
+}
+
+FitnessResult FitnessFunctions::FastEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, double exp_par) {
+    return PairwiseEfficiency(keyboard, model, words, exp_par);
+}
+
+FitnessResult FitnessFunctions::FastEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, double exp_par, PerfectVectorStore::Precision precision) {
+    return PairwiseEfficiency(keyboard, model, words, exp_par, precision);
+}
+
+FitnessResult FitnessFunctions::TruncatedFastEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, double exp_par, double epsilon) {
+    return TruncatedPairwiseEfficiency(keyboard, model, words, exp_par, epsilon);
+}
 
-    delete [] perfect;
-    return FitnessResult(0, totaleff/totalocc, 0);
+FitnessResult FitnessFunctions::TruncatedFastEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, double exp_par, double epsilon) {
+    return TruncatedPairwiseEfficiency(keyboard, model, words, exp_par, epsilon);
 }
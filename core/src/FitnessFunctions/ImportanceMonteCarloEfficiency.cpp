@@ -0,0 +1,69 @@
+#include "FitnessFunctions.h"
+#include "Instrumentation.h"
+#include "InputModels/InputVector.h"
+
+#include <boost/random/discrete_distribution.hpp>
+
+#include "string.h"
+#include "math.h"
+#include <iostream>
+#include <vector>
+using namespace std;
+
+FitnessResult FitnessFunctions::ImportanceMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, double exp_par) {
+    const ImportanceProposal proposal(keyboard, model, words, exp_par);
+    return ImportanceMonteCarloEfficiency(keyboard, model, words, iterations, proposal);
+}
+
+//Importance sampled Monte Carlo efficiency.  Words are drawn in proportion to
+//occurances*(mean confusion + confusion), with the confusions from the proposal.  Misses are
+//reweighted by p/q so the estimate stays unbiased, and mixing in the mean keeps the weights bounded by
+//a factor of 1/(mean confusion) for words that look safe.
+FitnessResult FitnessFunctions::ImportanceMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations,
+        const ImportanceProposal& proposal) {
+    const Instrumentation::Scope scope;
+    const unsigned int nwords = words.Words();
+    if(nwords == 0 || iterations == 0) {
+        return FitnessResult();
+    }
+    if(proposal.Words() != nwords || proposal.KeyboardHash() != keyboard.Hash() || proposal.ListFingerprint() != words.Fingerprint()) {
+        cerr << "ERROR: The importance proposal was built for a different keyboard or word list." << endl;
+        return FitnessResult();
+    }
+
+    double total = 0;
+    for(unsigned int i = 0; i < nwords; i++) {
+        total += words.Occurances(i);
+    }
+    const double mean_confusion = proposal.MeanConfusion();
+
+    //q_i is proportional to p_i*(mean + c_i) so the weight p_i/q_i is norm/(mean + c_i)
+    vector<double> q(nwords);
+    double norm = 0;
+    for(unsigned int i = 0; i < nwords; i++) {
+        q[i] = double(words.Occurances(i))*(mean_confusion > 0 ? mean_confusion + proposal.Confusion(i) : 1.0);
+        norm += q[i]/total;
+    }
+    boost::random::discrete_distribution<> distribution(q);
+
+    double missed = 0, missed2 = 0;
+    for(unsigned int iteration = 0; iteration < iterations; iteration++) {
+        const unsigned int index = distribution(words.Generator());
+        const char *word = words.Word(index);
+        InputVector sigma = model.RandomVector(word, keyboard);
+        const char *best_word = model.BestMatch(sigma, keyboard, words);
+
+        if(strcmp(word, best_word) != 0) {
+            const double weight = mean_confusion > 0 ? norm/(mean_confusion + proposal.Confusion(index)) : 1.0;
+            missed += weight;
+            missed2 += weight*weight;
+        }
+    }
+    missed /= double(iterations);
+    missed2 /= double(iterations);
+
+    const double fitness = 1.0 - missed;
+    const double error = sqrt( (missed2 - pow(missed, 2))/double(iterations) );
+
+    return scope.Attach(FitnessResult(iterations, fitness, error));
+}
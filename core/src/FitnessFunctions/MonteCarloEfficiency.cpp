@@ -1,33 +1,122 @@
 #include "FitnessFunctions.h"
+#include "Instrumentation.h"
+#include "Tracing.h"
 #include "InputModels/InputVector.h"
 
 #include "string.h"
 #include "math.h"
 
-FitnessResult FitnessFunctions::MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations) {
-    bool full_list = false;
-    if(iterations == 0) {
-        full_list = true;
-        iterations = words.Words();
+namespace {
+    //RandomWord() draws the next word from whichever list is being sampled
+    template<typename Words, typename Sampler> FitnessResult SampledEfficiency(Keyboard& keyboard, const InputModel& model, Words& words, unsigned int iterations,
+            Sampler RandomWord, boost::mt19937& noise) {
+        const Instrumentation::Scope scope;
+        Tracing::Span span("MonteCarloEfficiency", "fitness");
+        const uint64_t hash = keyboard.Hash();
+        span.SetKeyboard(hash);
+        bool full_list = false;
+        if(iterations == 0) {
+            full_list = true;
+            iterations = words.Words();
+        }
+
+        Tracing::Span batch("BestMatchBatch", "decode");
+        batch.SetKeyboard(hash);
+        unsigned int matched = 0, missed = 0;
+        for(unsigned int iteration = 0; iteration < iterations; iteration++) {
+            if(iteration > 0 && iteration % Tracing::bestmatch_batch == 0) batch.Next();
+            const char *word = full_list ? words.Word(iteration) : RandomWord();
+            InputVector sigma = model.RandomVector(word, keyboard, noise);
+            const char *best_word = model.BestMatch(sigma, keyboard, words);
+
+            if(strcmp(word, best_word) == 0) {
+                matched += full_list ? words.Occurances(iteration) : 1;
+            }
+            else {
+                missed += full_list ? words.Occurances(iteration) : 1;
+            }
+        }
+        batch.End();
+        const double fitness = double(matched)/double(missed+matched);
+
+        //no longer right if we're doing the full list - depends on the model, so set to 0 in that case
+        const double error = full_list ? 0 : sqrt( fitness*(1.0-fitness)/double(iterations));
+
+        span.SetFitness(fitness);
+        return scope.Attach(FitnessResult(iterations, fitness, error));
     }
+}
 
-    unsigned int matched = 0, missed = 0;
-    for(unsigned int iteration = 0; iteration < iterations; iteration++) {
-        const char *word = full_list ? words.Word(iteration) : words.RandomWord();
-        InputVector sigma = model.RandomVector(word, keyboard);
+FitnessResult FitnessFunctions::MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations) {
+    return SampledEfficiency(keyboard, model, words, iterations, [&words]() { return words.RandomWord(); }, model.Generator());
+}
+
+FitnessResult FitnessFunctions::MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations,
+        boost::mt19937& word_generator, boost::mt19937& noise_generator) {
+    return SampledEfficiency(keyboard, model, words, iterations, [&]() { return words.RandomWord(word_generator); }, noise_generator);
+}
+
+FitnessResult FitnessFunctions::MonteCarloEfficiency(Keyboard& keyboard, const InputModel& model, const FrozenWordList& words, unsigned int iterations,
+        boost::mt19937& word_generator, boost::mt19937& noise_generator) {
+    return SampledEfficiency(keyboard, model, words, iterations, [&]() { return words.RandomWord(word_generator); }, noise_generator);
+}
+
+namespace {
+    bool SampleMatched(Keyboard& keyboard, InputModel& model, WordList& words, SampleSet& samples, unsigned int i) {
+        const char *word = words.Word(samples.WordIndex(i));
+        InputVector sigma = model.OffsetVector(word, keyboard, samples.Offsets(i));
         const char *best_word = model.BestMatch(sigma, keyboard, words);
+        return strcmp(word, best_word) == 0;
+    }
+}
+
+//Replays a fixed sample set so that every keyboard sees exactly the same words and noise
+FitnessResult FitnessFunctions::MonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, SampleSet& samples) {
+    const Instrumentation::Scope scope;
+    Tracing::Span span("MonteCarloEfficiency", "fitness");
+    span.SetKeyboard(keyboard.Hash());
+    if(!samples.CheckList(words) || samples.Samples() == 0) {
+        return FitnessResult();
+    }
 
-        if(strcmp(word, best_word) == 0) {
-            matched += full_list ? words.Occurances(iteration) : 1;
+    const bool full_list = samples.FullList();
+    unsigned int matched = 0, missed = 0;
+    for(unsigned int i = 0; i < samples.Samples(); i++) {
+        const unsigned int weight = full_list ? words.Occurances(samples.WordIndex(i)) : 1;
+        if(SampleMatched(keyboard, model, words, samples, i)) {
+            matched += weight;
         }
         else {
-            missed += full_list ? words.Occurances(iteration) : 1;
+            missed += weight;
         }
     }
     const double fitness = double(matched)/double(missed+matched);
+    const double error = full_list ? 0 : sqrt( fitness*(1.0-fitness)/double(samples.Samples()));
+
+    span.SetFitness(fitness);
+    return scope.Attach(FitnessResult(samples.Samples(), fitness, error));
+}
 
-    //no longer right if we're doing the full list - depends on the model, so set to 0 in that case
-    const double error = full_list ? 0 : sqrt( fitness*(1.0-fitness)/double(iterations));
+//The efficiency of keyboard1 minus that of keyboard2 over the same samples.  The error comes from
+//the paired differences so the sampling noise common to both keyboards cancels out.
+FitnessResult FitnessFunctions::MonteCarloEfficiencyDifference(Keyboard& keyboard1, Keyboard& keyboard2, InputModel& model, WordList& words, SampleSet& samples) {
+    const Instrumentation::Scope scope;
+    if(!samples.CheckList(words) || samples.Samples() == 0) {
+        return FitnessResult();
+    }
+
+    const bool full_list = samples.FullList();
+    double total = 0, difference = 0, difference2 = 0;
+    for(unsigned int i = 0; i < samples.Samples(); i++) {
+        const double weight = full_list ? words.Occurances(samples.WordIndex(i)) : 1;
+        const double d = double(SampleMatched(keyboard1, model, words, samples, i)) - double(SampleMatched(keyboard2, model, words, samples, i));
+        total += weight;
+        difference += weight*d;
+        difference2 += weight*d*d;
+    }
+    difference /= total;
+    difference2 /= total;
+    const double error = full_list ? 0 : sqrt( (difference2 - pow(difference, 2))/double(samples.Samples()) );
 
-    return FitnessResult(iterations, fitness, error);
+    return scope.Attach(FitnessResult(samples.Samples(), difference, error));
 }
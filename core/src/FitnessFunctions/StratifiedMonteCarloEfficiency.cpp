@@ -0,0 +1,146 @@
+#include "FitnessFunctions.h"
+#include "Instrumentation.h"
+#include "InputModels/InputVector.h"
+
+#include <boost/random/discrete_distribution.hpp>
+
+#include "string.h"
+#include "math.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+namespace {
+    typedef vector< vector<unsigned int> > strata_list;
+
+    //Splits exactly iterations samples between the strata in proportion to their weights, rounding by
+    //largest remainder, then tops every non-empty stratum up to two samples out of the largest ones.
+    //false if there aren't two samples for each.
+    bool AllocateSamples(const vector<double>& weights, const strata_list& strata, unsigned int iterations, vector<unsigned int>& n) {
+        n.assign(strata.size(), 0);
+        unsigned int nonempty = 0, allocated = 0;
+        vector< pair<double, unsigned int> > remainders;
+        for(unsigned int h = 0; h < strata.size(); h++) {
+            if(strata[h].size() == 0) continue;
+            nonempty++;
+            const double quota = weights[h]*double(iterations);
+            n[h] = (unsigned int) floor(quota);
+            allocated += n[h];
+            //ties go to the earlier stratum
+            remainders.push_back(make_pair(-(quota - floor(quota)), h));
+        }
+        if(iterations < 2*nonempty) {
+            return false;
+        }
+        sort(remainders.begin(), remainders.end());
+        for(unsigned int r = 0; allocated < iterations && r < remainders.size(); r++, allocated++) {
+            n[remainders[r].second]++;
+        }
+
+        for(unsigned int h = 0; h < strata.size(); h++) {
+            while(strata[h].size() > 0 && n[h] < 2) {
+                const unsigned int largest = max_element(n.begin(), n.end()) - n.begin();
+                n[largest]--;
+                n[h]++;
+            }
+        }
+        return true;
+    }
+
+    //Estimates the efficiency from independent samples of each stratum.  Samples are allocated to the
+    //strata in proportion to their share of the occurances (at least two each so every stratum gets an
+    //error estimate) and words are drawn proportionally to their occurances within a stratum.
+    FitnessResult StratifiedEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, strata_list& strata) {
+        double total = 0;
+        vector<double> stratum_weights(strata.size(), 0);
+        for(unsigned int h = 0; h < strata.size(); h++) {
+            for(unsigned int i = 0; i < strata[h].size(); i++) {
+                stratum_weights[h] += words.Occurances(strata[h][i]);
+            }
+            total += stratum_weights[h];
+        }
+        if(total == 0) {
+            return FitnessResult();
+        }
+
+        for(unsigned int h = 0; h < strata.size(); h++) {
+            stratum_weights[h] /= total;
+        }
+        vector<unsigned int> allocation;
+        if(!AllocateSamples(stratum_weights, strata, iterations, allocation)) {
+            cerr << "ERROR: Stratified sampling needs at least two iterations for every non-empty stratum." << endl;
+            return FitnessResult();
+        }
+
+        double fitness = 0, variance = 0;
+        unsigned int samples = 0;
+        for(unsigned int h = 0; h < strata.size(); h++) {
+            if(strata[h].size() == 0) {
+                continue;
+            }
+            const double weight = stratum_weights[h];
+            const unsigned int n = allocation[h];
+
+            vector<unsigned int> occurances(strata[h].size());
+            for(unsigned int i = 0; i < strata[h].size(); i++) {
+                occurances[i] = words.Occurances(strata[h][i]);
+            }
+            boost::random::discrete_distribution<> distribution(occurances);
+
+            unsigned int matched = 0;
+            for(unsigned int iteration = 0; iteration < n; iteration++) {
+                const char *word = words.Word(strata[h][distribution(words.Generator())]);
+                InputVector sigma = model.RandomVector(word, keyboard);
+                const char *best_word = model.BestMatch(sigma, keyboard, words);
+                if(strcmp(word, best_word) == 0) {
+                    matched++;
+                }
+            }
+
+            const double p = double(matched)/double(n);
+            fitness += weight*p;
+            //with half a sample added to each outcome, so a small stratum that got everything right (or
+            //wrong) doesn't claim to be known exactly
+            const double pc = (double(matched) + 0.5)/(double(n) + 1.0);
+            variance += weight*weight*pc*(1.0-pc)/double(n);
+            samples += n;
+        }
+
+        return FitnessResult(samples, fitness, sqrt(variance));
+    }
+}
+
+//Stratifies the list into bands of consecutive (by frequency) words that each hold roughly the same
+//share of the occurances.  The very common words end up in small bands of their own.
+FitnessResult FitnessFunctions::StratifiedMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations, unsigned int bands) {
+    const Instrumentation::Scope scope;
+    if(bands == 0) {
+        bands = 1;
+    }
+
+    strata_list strata(1);
+    const double band_occurances = double(words.TotalOccurances())/double(bands);
+    double accumulated = 0;
+    for(unsigned int i = 0; i < words.Words(); i++) {
+        if(accumulated >= band_occurances*double(strata.size()) && strata.size() < bands) {
+            strata.push_back(vector<unsigned int>());
+        }
+        strata.back().push_back(i);
+        accumulated += words.Occurances(i);
+    }
+
+    return scope.Attach(StratifiedEfficiency(keyboard, model, words, iterations, strata));
+}
+
+//Stratifies the list by word length, words of MaxN() or more letters share the last stratum
+FitnessResult FitnessFunctions::LengthStratifiedMonteCarloEfficiency(Keyboard& keyboard, InputModel& model, WordList& words, unsigned int iterations) {
+    const Instrumentation::Scope scope;
+    strata_list strata(words.MaxN()+1);
+    for(unsigned int i = 0; i < words.Words(); i++) {
+        const unsigned int length = strlen(words.Word(i));
+        strata[min(length, words.MaxN())].push_back(i);
+    }
+
+    return scope.Attach(StratifiedEfficiency(keyboard, model, words, iterations, strata));
+}
@@ -1,15 +1,24 @@
 #include "FitnessResult.h"
+#include "PackedState.h"
 
 #include "math.h"
 
+using namespace std;
+
+namespace {
+    const char state_magic[8] = "DODOFIT";
+    const uint32_t state_version = 1;
+}
+
 FitnessResult::FitnessResult() {
     iterations = 0;
     fitness = 0;
     error = 0;
+    truncation = 0;
 }
 
 FitnessResult::FitnessResult(unsigned int iterations, double fitness, double error) 
-    : iterations(iterations), fitness(fitness), error(error) {
+    : iterations(iterations), fitness(fitness), error(error), truncation(0) {
 
 }
 
@@ -20,5 +29,55 @@ FitnessResult FitnessResult::operator+(const FitnessResult& other) {
     double newfitness = weight1*fitness + weight2*other.fitness;
     double newerror =  sqrt(pow(error*weight1, 2) + pow(other.error*weight2, 2));
 
-    return FitnessResult(newi, newfitness, newerror);
+    FitnessResult sum(newi, newfitness, newerror);
+    //the bounds are on the fitnesses themselves, so they're averaged the same way
+    sum.SetTruncation(weight1*truncation + weight2*other.truncation);
+    Instrumentation::Stats stats_sum = GetStats();
+    stats_sum += other.GetStats();
+    sum.SetStats(stats_sum);
+    return sum;
+}
+
+#ifdef DODONA_INSTRUMENTATION
+Instrumentation::Stats FitnessResult::GetStats() const {
+    return stats;
+}
+
+void FitnessResult::SetStats(const Instrumentation::Stats& s) {
+    stats = s;
+}
+#else
+Instrumentation::Stats FitnessResult::GetStats() const {
+    return Instrumentation::Stats();
+}
+
+void FitnessResult::SetStats(const Instrumentation::Stats& s) {
+}
+#endif
+
+string FitnessResult::PackState() const {
+    StateWriter state(state_magic, state_version);
+    state.PutU32(iterations);
+    state.PutDouble(fitness);
+    state.PutDouble(error);
+    state.PutDouble(truncation);
+    return state.State();
+}
+
+bool FitnessResult::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    uint32_t i = 0;
+    double f = 0, e = 0, t = 0;
+    state.GetU32(i);
+    state.GetDouble(f);
+    state.GetDouble(e);
+    state.GetDouble(t);
+    if(!state.Finished()) {
+        return false;
+    }
+    iterations = i;
+    fitness = f;
+    error = e;
+    truncation = t;
+    return true;
 }
@@ -0,0 +1,97 @@
+#include "FrozenWordList.h"
+
+#include <algorithm>
+#include <string.h>
+using namespace std;
+
+namespace {
+    class AlphabeticalOrder {
+        const string& text;
+        const vector<uint32_t>& offsets;
+      public:
+        AlphabeticalOrder(const string& t, const vector<uint32_t>& o) : text(t), offsets(o) {}
+        bool operator()(unsigned int a, unsigned int b) const {
+            return strcmp(text.c_str() + offsets[a], text.c_str() + offsets[b]) < 0;
+        }
+    };
+};
+
+FrozenWordList::FrozenWordList(WordList& words) {
+    const unsigned int n = words.Words();
+    offsets.reserve(n);
+    occurance_vector.reserve(n);
+    total = 0;
+    for(unsigned int i = 0; i < n; i++) {
+        const char *word = words.Word(i);
+        offsets.push_back(text.size());
+        text.append(word, strlen(word) + 1);
+        occurance_vector.push_back(words.Occurances(i));
+        total += occurance_vector.back();
+        const unsigned int l = strlen(word);
+        if(l > 0 && l <= MAXN) {
+            Nindex_vector[l-1].push_back(i);
+        }
+        tree.AddWord(word);
+    }
+
+    alphabetical.resize(n);
+    for(unsigned int i = 0; i < n; i++) alphabetical[i] = i;
+    sort(alphabetical.begin(), alphabetical.end(), AlphabeticalOrder(text, offsets));
+
+    //built from the same weights as the WordList's, so the same generator state draws the same word
+    distribution = boost::random::discrete_distribution<>(occurance_vector);
+    for(unsigned int c = 0; c < 128; c++) {
+        letters[c] = words.LetterOccurances(c);
+    }
+    total_letters = words.TotalLetterOccurances();
+    fingerprint = words.Fingerprint();
+}
+
+unsigned int FrozenWordList::Occurances(const char *word) const {
+    const int index = WordIndex(word);
+    return index >= 0 ? occurance_vector[index] : 0;
+}
+
+unsigned int FrozenWordList::NWords(const unsigned int N) const {
+    if(N < 1 || N > MAXN) {
+        return 0;
+    }
+    return Nindex_vector[N-1].size();
+}
+
+const char* FrozenWordList::NWord(const unsigned int N, const unsigned int index) const {
+    if(N < 1 || N > MAXN) {
+        return 0;
+    }
+    return Word(Nindex_vector[N-1][index]);
+}
+
+unsigned int FrozenWordList::NOccurances(const unsigned int N, const unsigned int index) const {
+    if(N < 1 || N > MAXN) {
+        return 0;
+    }
+    return occurance_vector[Nindex_vector[N-1][index]];
+}
+
+//a binary search of the alphabetical order rather than a scan of the list
+int FrozenWordList::WordIndex(const char* word) const {
+    unsigned int low = 0, high = alphabetical.size();
+    while(low < high) {
+        const unsigned int middle = low + (high - low)/2;
+        const int comparison = strcmp(Word(alphabetical[middle]), word);
+        if(comparison == 0) {
+            return alphabetical[middle];
+        }
+        if(comparison < 0) low = middle + 1;
+        else high = middle;
+    }
+    return -1;
+}
+
+unsigned int FrozenWordList::LetterOccurances(const char c) const {
+    const unsigned char usc = (unsigned char) c;
+    if(usc < 128) {
+        return letters[usc];
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "ImportanceProposal.h"
+#include "PerfectVectorIndex.h"
+#include "InputModels/InputVector.h"
+
+#include <map>
+#include <string.h>
+#include "math.h"
+
+using namespace std;
+
+namespace {
+    //pairs whose terms are closer to 1 than this are left out
+    const double neglected_term = 1e-6;
+
+    //1 - the product of the terms between each word of group and every other one
+    void GroupConfusion(const InputModel& model, vector<InputVector>& perfect, const vector<unsigned int>& group, double exp_par, vector<double>& confusion) {
+        const unsigned int n = group.size();
+        vector<InputVector> vectors(n);
+        for(unsigned int a = 0; a < n; a++) {
+            vectors[a] = perfect[group[a]];
+        }
+
+        PerfectVectorIndex index;
+        if(model.EuclideanDistance() && exp_par > 0 && n > 0 && index.Build(&vectors[0], n)) {
+            //as in TruncatedFastEfficiency, a cap inside the radius puts every pair beyond it at exactly the cap
+            const double maxd = model.MaxDistance();
+            const double cutoff = -log(neglected_term)/exp_par;
+            const bool capped = maxd > 0 && maxd < cutoff;
+            const double beyond = capped ? 1.0-0.5*exp(-exp_par*maxd) : 1.0;
+            vector<unsigned int> neighbours;
+            vector<double> distances;
+            for(unsigned int a = 0; a < n; a++) {
+                index.Within(a, capped ? maxd : cutoff, neighbours, distances);
+                double singleeff = 1;
+                unsigned int others = 0;
+                for(unsigned int k = 0; k < neighbours.size(); k++) {
+                    if(neighbours[k] == a) continue;
+                    singleeff *= 1.0-0.5*exp(-exp_par*distances[k]);
+                    others++;
+                }
+                if(capped) singleeff *= pow(beyond, double(n - 1 - others));
+                confusion[group[a]] = 1.0 - singleeff;
+            }
+            return;
+        }
+
+        for(unsigned int a = 0; a < n; a++) {
+            double singleeff = 1;
+            for(unsigned int b = 0; b < n; b++) {
+                if(a == b) continue;
+                singleeff *= 1.0-0.5*exp(-exp_par*model.VectorDistance(vectors[a], vectors[b]));
+            }
+            confusion[group[a]] = 1.0 - singleeff;
+        }
+    }
+};
+
+ImportanceProposal::ImportanceProposal() {
+    mean_confusion = 0;
+    keyboard_hash = list_fingerprint = 0;
+}
+
+ImportanceProposal::ImportanceProposal(Keyboard& keyboard, const InputModel& model, WordList& words, double exp_par) {
+    Build(keyboard, model, words, exp_par);
+}
+
+void ImportanceProposal::Build(Keyboard& keyboard, const InputModel& model, WordList& words, double exp_par) {
+    const unsigned int nwords = words.Words();
+    keyboard_hash = keyboard.Hash();
+    list_fingerprint = words.Fingerprint();
+    confusion.assign(nwords, 0);
+    mean_confusion = 0;
+
+    //fixed length models never compare words of different lengths
+    vector<InputVector> perfect(nwords);
+    map<unsigned int, vector<unsigned int> > groups;
+    for(unsigned int i = 0; i < nwords; i++) {
+        perfect[i] = model.PerfectVector(words.Word(i), keyboard);
+        groups[model.FixedLength() ? strlen(words.Word(i)) : 0].push_back(i);
+    }
+    for(map<unsigned int, vector<unsigned int> >::iterator it = groups.begin(); it != groups.end(); it++) {
+        GroupConfusion(model, perfect, it->second, exp_par, confusion);
+    }
+
+    double total = 0;
+    for(unsigned int i = 0; i < nwords; i++) {
+        total += words.Occurances(i);
+        mean_confusion += confusion[i]*double(words.Occurances(i));
+    }
+    if(total > 0) mean_confusion /= total;
+}
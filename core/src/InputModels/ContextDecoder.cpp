@@ -0,0 +1,177 @@
+#include "InputModels/ContextDecoder.h"
+#include "RadixTree.h"
+
+#include <boost/random/mersenne_twister.hpp>
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace {
+    //a partial sequence: its score, the candidate it ends with and the hypothesis before it
+    class Hypothesis {
+      public:
+        double cost;
+        const char *previous, *last;
+        uint32_t u, v;
+        int parent;
+        unsigned int candidate;
+    };
+
+    bool CheaperHypothesis(const Hypothesis& a, const Hypothesis& b) {
+        return a.cost < b.cost;
+    }
+};
+
+void ContextDecoder::Candidates(const InputModel& model, InputVector& vector, Keyboard& k, WordList& w, NGramModel& lm,
+        std::vector<Candidate>& candidates) {
+    //a path is pruned to the radix tree's matches, each once, so only those have their distance taken.
+    //Taps only match words whose every key was hit, which loses too many, so they keep to the words of
+    //their length.
+    std::vector<const char*> words;
+    if(!model.FixedLength()) {
+        const char *stringform = vector.StringForm(k);
+        std::vector<string> matches = w.GetTree()->Matches(stringform);
+        delete [] stringform;
+        sort(matches.begin(), matches.end());
+        matches.erase(unique(matches.begin(), matches.end()), matches.end());
+        words.reserve(matches.size());
+        for(unsigned int i = 0; i < matches.size(); i++) {
+            const char *word = w.Find(matches[i].c_str());
+            if(word != 0) words.push_back(word);
+        }
+    }
+    //otherwise the same words InputModel::BestMatch compares, in the same order
+    if(words.size() == 0) {
+        const unsigned int length = vector.Length();
+        const bool by_length = model.FixedLength() && length <= w.MaxN() && length > 0;
+        const unsigned int n = by_length ? w.NWords(length) : w.Words();
+        words.resize(n);
+        for(unsigned int i = 0; i < n; i++) {
+            words[i] = by_length ? w.NWord(length, i) : w.Word(i);
+        }
+    }
+
+    std::vector< pair<double, unsigned int> > distances(words.size());
+    for(unsigned int i = 0; i < words.size(); i++) {
+        distances[i] = make_pair(model.Distance(vector, words[i], k), i);
+    }
+    const unsigned int kept = min(max(beam, 1u), (unsigned int) words.size());
+    partial_sort(distances.begin(), distances.begin() + kept, distances.end());
+
+    candidates.resize(kept);
+    for(unsigned int c = 0; c < kept; c++) {
+        candidates[c].word = words[distances[c].second];
+        candidates[c].distance = distances[c].first;
+        candidates[c].id = lm.WordId(candidates[c].word);
+    }
+}
+
+const char* ContextDecoder::BestMatch(const InputModel& model, InputVector& vector, Keyboard& k, WordList& w, NGramModel& lm,
+        const std::vector<string>& context) {
+    std::vector<Candidate> candidates;
+    Candidates(model, vector, k, w, lm, candidates);
+    uint32_t u = NGramModel::unknown, v = NGramModel::unknown;
+    if(context.size() >= 1) v = lm.WordId(context[context.size()-1].c_str());
+    if(context.size() >= 2) u = lm.WordId(context[context.size()-2].c_str());
+
+    const char *best_word = 0;
+    double best_cost = 0;
+    for(unsigned int c = 0; c < candidates.size(); c++) {
+        const double cost = distance_weight*candidates[c].distance - lm_weight*lm.LogProbability(u, v, candidates[c].id);
+        if(cost < best_cost || c == 0) {
+            best_word = candidates[c].word;
+            best_cost = cost;
+        }
+    }
+    return best_word;
+}
+
+std::vector<string> ContextDecoder::Decode(const InputModel& model, std::vector<InputVector>& vectors, Keyboard& k, WordList& w,
+        NGramModel& lm) {
+    lm.Prepare();
+    std::vector< std::vector<Candidate> > candidates(vectors.size());
+    std::vector< std::vector<Hypothesis> > steps(vectors.size());
+    std::vector<Hypothesis> live(1);
+    live[0].cost = 0;
+    live[0].previous = live[0].last = 0;
+    live[0].u = live[0].v = NGramModel::unknown;
+    live[0].parent = -1;
+    live[0].candidate = 0;
+
+    for(unsigned int s = 0; s < vectors.size(); s++) {
+        Candidates(model, vectors[s], k, w, lm, candidates[s]);
+        //a vector no word could have made (e.g. a length the list has no words of) decodes to nothing,
+        //like InputModel::BestMatch, and the hypotheses carry on past it unchanged in cost
+        const bool unmatched = candidates[s].size() == 0;
+        if(unmatched) {
+            Candidate none;
+            none.word = 0;
+            none.distance = 0;
+            none.id = NGramModel::unknown;
+            candidates[s].push_back(none);
+        }
+        std::vector<Hypothesis> next;
+        for(unsigned int h = 0; h < live.size(); h++) {
+            for(unsigned int c = 0; c < candidates[s].size(); c++) {
+                const Candidate& candidate = candidates[s][c];
+                Hypothesis e;
+                e.cost = live[h].cost;
+                if(!unmatched) e.cost += distance_weight*candidate.distance - lm_weight*lm.LogProbability(live[h].u, live[h].v, candidate.id);
+                e.previous = live[h].last;
+                e.last = candidate.word;
+                e.u = live[h].v;
+                e.v = candidate.id;
+                e.parent = s > 0 ? h : -1;
+                e.candidate = c;
+                next.push_back(e);
+            }
+        }
+
+        //hypotheses ending in the same two words can't be told apart by anything later so only the
+        //cheapest is kept, then the beam cheapest of those
+        stable_sort(next.begin(), next.end(), CheaperHypothesis);
+        live.clear();
+        for(unsigned int h = 0; h < next.size() && live.size() < max(beam, 1u); h++) {
+            bool duplicate = false;
+            for(unsigned int l = 0; l < live.size() && !duplicate; l++) {
+                duplicate = live[l].last == next[h].last && live[l].previous == next[h].previous;
+            }
+            if(!duplicate) live.push_back(next[h]);
+        }
+        steps[s] = live;
+    }
+
+    std::vector<string> words(vectors.size());
+    if(vectors.size() == 0) return words;
+    int h = 0;
+    for(int s = vectors.size() - 1; s >= 0; s--) {
+        const Hypothesis& hypothesis = steps[s][h];
+        words[s] = hypothesis.last != 0 ? hypothesis.last : "";
+        h = hypothesis.parent;
+    }
+    return words;
+}
+
+DecodingReport ContextDecoder::Accuracy(const InputModel& model, Keyboard& k, WordList& w, NGramModel& lm,
+        const std::vector<string>& text, unsigned int seed) {
+    DecodingReport report;
+    boost::mt19937 generator(seed);
+    std::vector<string> intended;
+    std::vector<InputVector> vectors;
+    for(unsigned int i = 0; i < text.size(); i++) {
+        if(w.Occurances(text[i].c_str()) == 0) continue;
+        intended.push_back(text[i]);
+        vectors.push_back(model.RandomVector(text[i].c_str(), k, generator));
+    }
+
+    const std::vector<string> decoded = Decode(model, vectors, k, w, lm);
+    for(unsigned int i = 0; i < intended.size(); i++) {
+        report.words++;
+        if(i < decoded.size() && decoded[i] == intended[i]) report.correct++;
+        const char *baseline = model.BestMatch(vectors[i], k, w);
+        if(baseline != 0 && intended[i] == baseline) report.baseline_correct++;
+    }
+    return report;
+}
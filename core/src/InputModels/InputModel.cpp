@@ -1,30 +1,60 @@
 #include "InputModels/InputModel.h"
+#include "FrozenWordList.h"
+#include "Instrumentation.h"
 
-const char* InputModel::BestMatch(InputVector& vector, Keyboard& keyboard, WordList &words) {
-    const char *best_word = 0;
-    double best_distance = 0;
-
-    const unsigned int wordlength = vector.Length();
-    if(FixedLength() && wordlength <= words.MaxN() && wordlength > 0) {
-        for(unsigned int i = 0; i < words.NWords(wordlength); i++) {
-            const char *possible_word = words.NWord(wordlength, i);
-            const double distance = Distance(vector, possible_word, keyboard);
-            if(distance < best_distance || i == 0) {
-                best_word = possible_word;
-                best_distance = distance;
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+
+InputVector InputModel::OffsetVector(const char* word, Keyboard& k, const double* offsets) const {
+    cerr << "ERROR: This input model can't replay a SampleSet's noise." << endl;
+    throw runtime_error("This input model doesn't implement OffsetVector");
+}
+
+void InputModel::VectorDistanceBatch(InputVector& vector, InputVector* vectors, unsigned int n, double* distances) const {
+    for(unsigned int i = 0; i < n; i++) {
+        distances[i] = VectorDistance(vector, vectors[i]);
+    }
+}
+
+namespace {
+    //the first word with the lowest distance, among the words of the vector's length for fixed length models
+    template<typename Words> const char* ClosestWord(const InputModel& model, InputVector& vector, Keyboard& keyboard, Words& words) {
+        const char *best_word = 0;
+        double best_distance = 0;
+
+        const unsigned int wordlength = vector.Length();
+        if(model.FixedLength() && wordlength <= words.MaxN() && wordlength > 0) {
+            DODONA_COUNT(BestMatchCandidates, words.NWords(wordlength));
+            for(unsigned int i = 0; i < words.NWords(wordlength); i++) {
+                const char *possible_word = words.NWord(wordlength, i);
+                const double distance = model.Distance(vector, possible_word, keyboard);
+                if(distance < best_distance || i == 0) {
+                    best_word = possible_word;
+                    best_distance = distance;
+                }
             }
         }
-    }
-    else {
-        for(unsigned int i = 0; i < words.Words(); i++) {
-            const char *possible_word = words.Word(i);
-            const double distance = Distance(vector, possible_word, keyboard);
-            if(distance < best_distance || i == 0) {
-                best_word = possible_word;
-                best_distance = distance;
+        else {
+            DODONA_COUNT(BestMatchCandidates, words.Words());
+            for(unsigned int i = 0; i < words.Words(); i++) {
+                const char *possible_word = words.Word(i);
+                const double distance = model.Distance(vector, possible_word, keyboard);
+                if(distance < best_distance || i == 0) {
+                    best_word = possible_word;
+                    best_distance = distance;
+                }
             }
         }
+
+        return best_word;
     }
+};
+
+const char* InputModel::BestMatch(InputVector& vector, Keyboard& keyboard, WordList &words) const {
+    return ClosestWord(*this, vector, keyboard, words);
+}
 
-    return best_word;
+const char* InputModel::BestMatch(InputVector& vector, Keyboard& keyboard, const FrozenWordList &words) const {
+    return ClosestWord(*this, vector, keyboard, words);
 }
@@ -1,18 +1,33 @@
 #include "InputModels/InputVector.h"
+#include "Instrumentation.h"
+#include "PackedState.h"
 
 #include "math.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <string.h>
 
 using namespace std;
 
+namespace {
+    const char state_magic[8] = "DODOIVC";
+    const uint32_t state_version = 1;
+
+    struct TimeOrder {
+        const vector<double>& t;
+        TimeOrder(const vector<double>& times) : t(times) {}
+        bool operator()(unsigned int a, unsigned int b) const { return t[a] < t[b]; }
+    };
+};
+
 unsigned int InputVector::Length() {
     return xvector.size();
 }
 
 unsigned int InputVector::AddPoint(double x, double y, double t) {
+    if(xvector.size() == xvector.capacity()) DODONA_COUNT(Allocations, 3);
     unsigned int i;
     for(i = 0; i < tvector.size(); i++) {
         if(t < tvector.at(i)) {
@@ -27,6 +42,30 @@ unsigned int InputVector::AddPoint(double x, double y, double t) {
     return Length();
 }
 
+unsigned int InputVector::Append(double x, double y, double t) {
+    if(!tvector.empty() && t < tvector.back()) {
+        return AddPoint(x, y, t);
+    }
+    if(xvector.size() == xvector.capacity()) DODONA_COUNT(Allocations, 3);
+    xvector.push_back(x);
+    yvector.push_back(y);
+    tvector.push_back(t);
+    return Length();
+}
+
+void InputVector::Clear() {
+    xvector.clear();
+    yvector.clear();
+    tvector.clear();
+}
+
+void InputVector::Reserve(unsigned int n) {
+    if(n > xvector.capacity()) DODONA_COUNT(Allocations, 3);
+    xvector.reserve(n);
+    yvector.reserve(n);
+    tvector.reserve(n);
+}
+
 void InputVector::RemovePoint(int i) {
     while(i<0) { i += Length(); }
     if((unsigned int) i >= xvector.size()) {
@@ -68,6 +107,35 @@ void InputVector::SetT(int i, double t) {
     tvector.at(i) = t;
 }
 
+void InputVector::SetPoints(const double* points, unsigned int n) {
+    if(n > xvector.capacity()) DODONA_COUNT(Allocations, 3);
+    xvector.resize(n);
+    yvector.resize(n);
+    tvector.resize(n);
+    bool ordered = true;
+    for(unsigned int i = 0; i < n; i++) {
+        xvector[i] = points[3*i];
+        yvector[i] = points[3*i+1];
+        tvector[i] = points[3*i+2];
+        if(i > 0 && tvector[i] < tvector[i-1]) ordered = false;
+    }
+    if(ordered) return;
+
+    //AddPoint places equal times after the existing ones, which is what a stable sort does
+    vector<unsigned int> order(n);
+    for(unsigned int i = 0; i < n; i++) order[i] = i;
+    stable_sort(order.begin(), order.end(), TimeOrder(tvector));
+    vector<double> x(n), y(n), t(n);
+    for(unsigned int i = 0; i < n; i++) {
+        x[i] = xvector[order[i]];
+        y[i] = yvector[order[i]];
+        t[i] = tvector[order[i]];
+    }
+    xvector.swap(x);
+    yvector.swap(y);
+    tvector.swap(t);
+}
+
 double InputVector::SpatialLength() {
     double l = 0;
     for(unsigned int i = 1; i < xvector.size(); i++) {
@@ -115,3 +183,36 @@ const char* InputVector::StringForm(Keyboard& k) {
 
     return newstring;
 }
+
+string InputVector::PackState() const {
+    StateWriter state(state_magic, state_version);
+    state.Reserve(4 + 24*xvector.size());
+    state.PutU32(xvector.size());
+    for(unsigned int i = 0; i < xvector.size(); i++) {
+        state.PutDouble(xvector[i]);
+        state.PutDouble(yvector[i]);
+        state.PutDouble(tvector[i]);
+    }
+    return state.State();
+}
+
+bool InputVector::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    uint32_t n = 0;
+    if(!state.GetU32(n) || !state.Fits(n, 24)) {
+        return false;
+    }
+    vector<double> x(n), y(n), t(n);
+    for(unsigned int i = 0; i < n; i++) {
+        state.GetDouble(x[i]);
+        state.GetDouble(y[i]);
+        state.GetDouble(t[i]);
+    }
+    if(!state.Finished()) {
+        return false;
+    }
+    xvector.swap(x);
+    yvector.swap(y);
+    tvector.swap(t);
+    return true;
+}
@@ -0,0 +1,98 @@
+#include "InputModels/InputVectorBatch.h"
+#include "PackedState.h"
+
+#include <iostream>
+using namespace std;
+
+namespace {
+    const char state_magic[8] = "DODOBAT";
+    const uint32_t state_version = 1;
+}
+
+InputVectorBatch::InputVectorBatch(unsigned int p) {
+    points = p;
+    vectors = 0;
+}
+
+bool InputVectorBatch::Add(InputVector& v) {
+    if(points == 0 && vectors == 0) {
+        points = v.Length();
+    }
+    if(v.Length() != points) {
+        cerr << "ERROR: A vector with " << v.Length() << " points can't be added to a batch of " << points << " point vectors." << endl;
+        return false;
+    }
+
+    const size_t start = data.size();
+    data.resize(start + 3*points);
+    for(unsigned int i = 0; i < points; i++) {
+        data[start + 3*i] = v.X(i);
+        data[start + 3*i + 1] = v.Y(i);
+        data[start + 3*i + 2] = v.T(i);
+    }
+    vectors++;
+    return true;
+}
+
+InputVector InputVectorBatch::Get(unsigned int i) const {
+    InputVector v;
+    if(i < vectors) {
+        v.SetPoints(&data[3*points*i], points);
+    }
+    return v;
+}
+
+unsigned int InputVectorBatch::AddRandom(InputModel& model, Keyboard& k, const char* word, unsigned int n) {
+    Reserve(vectors + n);
+    unsigned int added = 0;
+    for(unsigned int i = 0; i < n; i++) {
+        InputVector v = model.RandomVector(word, k);
+        if(Add(v)) added++;
+    }
+    return added;
+}
+
+unsigned int InputVectorBatch::AddSamples(InputModel& model, Keyboard& k, WordList& words, SampleSet& samples) {
+    if(!samples.CheckList(words)) {
+        return 0;
+    }
+    Reserve(vectors + samples.Samples());
+    unsigned int added = 0;
+    for(unsigned int i = 0; i < samples.Samples(); i++) {
+        InputVector v = model.OffsetVector(words.Word(samples.WordIndex(i)), k, samples.Offsets(i));
+        if(Add(v)) added++;
+    }
+    return added;
+}
+
+string InputVectorBatch::PackState() const {
+    StateWriter state(state_magic, state_version);
+    state.Reserve(16 + 8*data.size());
+    state.PutU32(points);
+    state.PutU32(vectors);
+    state.PutU64(data.size());
+    for(unsigned int i = 0; i < data.size(); i++) {
+        state.PutDouble(data[i]);
+    }
+    return state.State();
+}
+
+bool InputVectorBatch::UnpackState(const char* state_data, size_t size) {
+    StateReader state(state_data, size, state_magic, state_version);
+    uint32_t p = 0, v = 0;
+    uint64_t n = 0;
+    if(!state.GetU32(p) || !state.GetU32(v) || !state.GetU64(n) || n != 3*uint64_t(p)*v || !state.Fits(n, 8)) {
+        return false;
+    }
+    vector<double> read(n);
+    for(unsigned int i = 0; i < n; i++) {
+        state.GetDouble(read[i]);
+    }
+    if(!state.Finished()) {
+        return false;
+    }
+    data.swap(read);
+    points = p;
+    vectors = v;
+    return true;
+}
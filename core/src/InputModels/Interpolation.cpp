@@ -2,50 +2,40 @@
 
 #include "math.h"
 
+#include <vector>
+
 //Helper functions
 namespace {
-    //This function simply returns the list of points from a quadratic bezier interpolation
-    //of three control points.
-    InputVector QuadraticBezierInterpolation(InputVector& iv, unsigned int Nsteps) {
-        InputVector newIV;
+    //The intermediate vectors and coefficients of the interpolations, kept per thread so that once they
+    //have grown to fit the longest word nothing is allocated.  An interpolation only hands them on to
+    //SpatialInterpolation, which doesn't use them, so no two calls are ever using them at once.
+    class Scratch {
+      public:
+        InputVector control, combined;
+        std::vector<double> t, y[2], delta[2], m[2];
+    };
+
+    Scratch& LocalScratch() {
+        static thread_local Scratch scratch;
+        return scratch;
+    }
 
-        for(unsigned int i = 0; i <= Nsteps; i++)
+    //This function simply adds the list of points from a quadratic bezier interpolation
+    //of control points i, i+1 and i+2 of iv to the end of out, leaving off the first if skip_first
+    //is set because it's where the last segment ended.
+    void QuadraticBezierInterpolation(InputVector& iv, unsigned int i, unsigned int Nsteps, InputVector& out, bool skip_first) {
+        for(unsigned int j = skip_first ? 1 : 0; j <= Nsteps; j++)
         {
             //find the endpoints for the line that contains the new points (as a function of t)
-            double px1 = iv.X(0)+(iv.X(1)-iv.X(0))*(i/double(Nsteps));
-            double py1 = iv.Y(0)+(iv.Y(1)-iv.Y(0))*(i/double(Nsteps));
-            double px2 = iv.X(1)+(iv.X(2)-iv.X(1))*(i/double(Nsteps));
-            double py2 = iv.Y(1)+(iv.Y(2)-iv.Y(1))*(i/double(Nsteps));
+            double px1 = iv.X(i)+(iv.X(i+1)-iv.X(i))*(j/double(Nsteps));
+            double py1 = iv.Y(i)+(iv.Y(i+1)-iv.Y(i))*(j/double(Nsteps));
+            double px2 = iv.X(i+1)+(iv.X(i+2)-iv.X(i+1))*(j/double(Nsteps));
+            double py2 = iv.Y(i+1)+(iv.Y(i+2)-iv.Y(i+1))*(j/double(Nsteps));
 
-            double newT = iv.T(0)+(iv.T(2)-iv.T(0))*(i/double(Nsteps));
+            double newT = iv.T(i)+(iv.T(i+2)-iv.T(i))*(j/double(Nsteps));
 
-            newIV.AddPoint(px1+(px2-px1)*(i/double(Nsteps)),py1+(py2-py1)*(i/double(Nsteps)),newT);
+            out.Append(px1+(px2-px1)*(j/double(Nsteps)),py1+(py2-py1)*(j/double(Nsteps)),newT);
         }
-
-        return newIV;
-    }
-
-
-    //Helper function that combines a vector of InputVectors into a single continuous InputVector.
-    //The input vectors must be ordered correctly in the vector
-    InputVector CombineInputVectors(std::vector<InputVector> IVvect) {
-        InputVector newIV;
-
-        for(unsigned int i = 0; i < IVvect.size(); i++) {
-            if(i==0) {
-                for(unsigned int j=0; j < IVvect[i].Length(); j++) {
-                    newIV.AddPoint(IVvect[i].X(j),IVvect[i].Y(j),IVvect[i].T(j));
-                }
-            }
-
-            else {
-                for(unsigned int j=1; j < IVvect[i].Length(); j++) {
-                    newIV.AddPoint(IVvect[i].X(j),IVvect[i].Y(j),IVvect[i].T(j));
-                }
-            }
-        }
-
-        return newIV;
     }
 
 
@@ -63,41 +53,36 @@ namespace {
 
 
 //Linear interpolation between points
-InputVector SpatialInterpolation(InputVector& iv, unsigned int Nsteps) {
+void SpatialInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
     const unsigned int points = iv.Length();
-    
+    out.Clear();
+    out.Reserve(Nsteps);
+
     //If it's a one letter word then fill the entire input vector with the same point.
     //This is to ensure that it has the same vector length as every other input vector.
     //The time vector is normalized to always take 0.1 seconds for one letter words,
     //regardless of the number of steps in the interpolation
     if(points == 1) {
-        InputVector newiv;
-        for(unsigned int i = 0; i < Nsteps; i++) 
-            newiv.AddPoint(iv.X(0), iv.Y(0), iv.T(double(i)*(0.1/double(Nsteps))));
-        return newiv;
+        for(unsigned int i = 0; i < Nsteps; i++)
+            out.Append(iv.X(0), iv.Y(0), iv.T(double(i)*(0.1/double(Nsteps))));
+        return;
     }
 
     const double length = iv.SpatialLength();
     const double steplength = length/(double(Nsteps)-1.0);
 
-    InputVector newiv;
-    newiv.AddPoint(iv.X(0), iv.Y(0), iv.T(0));
+    out.Append(iv.X(0), iv.Y(0), iv.T(0));
+    //the steps only move forwards along the vector, so the segment search carries on from the last one
+    unsigned int low_point = 0, high_point = 1;
+    double low_distance = 0, high_distance = sqrt( pow( iv.X(1)-iv.X(0), 2) + pow( iv.Y(1) - iv.Y(0), 2) );
     for(unsigned int i = 1; i < Nsteps-1; i++) {
         double current_distance = steplength*double(i);
 
-        unsigned int low_point = 0, high_point = 1;
-        double low_distance = 0, high_distance = 0;
-
-        while(true) {
-            high_distance += sqrt( pow( iv.X(high_point)-iv.X(low_point), 2) + pow( iv.Y(high_point) - iv.Y(low_point), 2) );
-
-            if(high_distance >= current_distance || high_point+1 == points) {
-                break;
-            }
-
+        while(high_distance < current_distance && high_point+1 != points) {
             low_distance = high_distance;
             low_point = high_point;
             high_point++;
+            high_distance += sqrt( pow( iv.X(high_point)-iv.X(low_point), 2) + pow( iv.Y(high_point) - iv.Y(low_point), 2) );
         }
         double high_weight = (current_distance - low_distance)/(high_distance-low_distance);
         if(high_distance == low_distance) { high_weight = 0.5; }
@@ -106,37 +91,44 @@ InputVector SpatialInterpolation(InputVector& iv, unsigned int Nsteps) {
         double newx = iv.X(high_point)*high_weight + iv.X(low_point)*low_weight;
         double newy = iv.Y(high_point)*high_weight + iv.Y(low_point)*low_weight;
         double newt = iv.T(high_point)*high_weight + iv.T(low_point)*low_weight;
-        newiv.AddPoint(newx, newy, newt);
+        out.Append(newx, newy, newt);
     }
 
     if(Nsteps > 1) {
-        newiv.AddPoint(iv.X(points-1), iv.Y(points-1), iv.T(points-1));
+        out.Append(iv.X(points-1), iv.Y(points-1), iv.T(points-1));
     }
-
-    return newiv;
 }
 
 
 //Cubic spline interpolation using the Hermite polynomial representation.
 //Has the option to do monotonic interpolation between points.
-InputVector HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool monotonic) {
+void HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool monotonic, InputVector& out) {
     const unsigned int points = iv.Length();
 
     //if less than three letters don't do any fancy interpolation
-    if(points <= 2)
-        return SpatialInterpolation(iv, Nsteps);
+    if(points <= 2) {
+        SpatialInterpolation(iv, Nsteps, out);
+        return;
+    }
 
-    double *t = new double [points];
-    double *y[2] = {new double [points], new double [points]};
+    Scratch& scratch = LocalScratch();
+    std::vector<double>& t = scratch.t;
+    std::vector<double> (&y)[2] = scratch.y;
+    //Slopes of the secant lines
+    std::vector<double> (&delta)[2] = scratch.delta;
+    //Tangents at each data point (average of the secants)
+    std::vector<double> (&m)[2] = scratch.m;
+    t.resize(points);
+    for(unsigned int dimension = 0; dimension < 2; dimension++) {
+        y[dimension].resize(points);
+        delta[dimension].resize(points-1);
+        m[dimension].resize(points);
+    }
     for(unsigned int i = 0; i <  points; i++) {
         t[i] = iv.T(i);
         y[0][i] = iv.X(i);
         y[1][i] = iv.Y(i);
     }
-    //Slopes of the secant lines
-    double *delta[2] = {new double [points-1], new double [points-1]};
-    //Tangents at each data point (average of the secants)
-    double *m[2] = {new double [points], new double [points]};
 
     for(unsigned int dimension = 0; dimension < 2; dimension++) {
         for(unsigned int i = 0; i <  points - 1; i++) {
@@ -173,8 +165,10 @@ InputVector HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Ns
     }
 
     //Create the new interpolated vector
-    InputVector newiv;
-    newiv.AddPoint(iv.X(0), iv.Y(0), iv.T(0));
+    InputVector& newiv = scratch.combined;
+    newiv.Clear();
+    newiv.Reserve(Nsteps);
+    newiv.Append(iv.X(0), iv.Y(0), iv.T(0));
     const double start_time = iv.T(0), end_time = iv.T(-1);
     const double total_time = end_time - start_time;
     unsigned int lower = 0;
@@ -190,44 +184,39 @@ InputVector HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Ns
         const double current_x = iv.X(lower)*h00(t) + h*m[0][lower]*h10(t) + iv.X(upper)*h01(t) + h*m[0][upper]*h11(t);
         const double current_y = iv.Y(lower)*h00(t) + h*m[1][lower]*h10(t) + iv.Y(upper)*h01(t) + h*m[1][upper]*h11(t);
 
-        newiv.AddPoint(current_x, current_y, current_time);
+        newiv.Append(current_x, current_y, current_time);
     }
     if(Nsteps > 1) {
-        newiv.AddPoint(iv.X(-1), iv.Y(-1), iv.T(-1));
+        newiv.Append(iv.X(-1), iv.Y(-1), iv.T(-1));
     }
 
-    delete [] t;
-    for(unsigned int dimension = 0; dimension < 2; dimension++) {
-        delete [] m[dimension];
-        delete [] y[dimension];
-        delete [] delta[dimension];
-    }
-
-    return SpatialInterpolation(newiv, Nsteps);
+    SpatialInterpolation(newiv, Nsteps, out);
 }
 
 
 //Monotonic hermite cubic spline interpolation
-InputVector MonotonicCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
-    return HermiteCubicSplineInterpolationBase(iv, Nsteps, true);
+void MonotonicCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
+    HermiteCubicSplineInterpolationBase(iv, Nsteps, true, out);
 }
 
 
 //Normal Hermite cubic spline interpolation
-InputVector HermiteCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
-    return HermiteCubicSplineInterpolationBase(iv, Nsteps, false);
+void HermiteCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
+    HermiteCubicSplineInterpolationBase(iv, Nsteps, false, out);
 }
 
 
 //New cubic spline interpolation function base.  Has the option to do normal cubic
-//spline interpolation or to do the "modified" cubic spline interpolation which 
+//spline interpolation or to do the "modified" cubic spline interpolation which
 //constrains the first and last spline to be a straight line.
-InputVector CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool mod) {
+void CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool mod, InputVector& out) {
     const unsigned int nPoints = iv.Length();
     const unsigned int Nsplines = nPoints-1;
 
-    if (nPoints <= 2)
-        return SpatialInterpolation(iv,Nsteps);
+    if (nPoints <= 2) {
+        SpatialInterpolation(iv,Nsteps,out);
+        return;
+    }
 
     //Algorithm coefficients
     double Dx[nPoints],cpx[Nsplines],dpx[nPoints];
@@ -261,12 +250,12 @@ InputVector CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, b
                 cpy[i] = 1.0/(4.0-cpy[i-1]);
 
                 dpx[i] = (3.0*(iv.X(i+1)-iv.X(i-1))-dpx[i-1])/(4.0-cpx[i-1]);
-                dpy[i] = (3.0*(iv.Y(i+1)-iv.Y(i-1))-dpy[i-1])/(4.0-cpy[i-1]); 
+                dpy[i] = (3.0*(iv.Y(i+1)-iv.Y(i-1))-dpy[i-1])/(4.0-cpy[i-1]);
             }
         }
         else {
             dpx[i] = (3.0*(iv.X(i)-iv.X(i-1))-dpx[i-1])/(2.0-cpx[i-1]);
-            dpy[i] = (3.0*(iv.Y(i)-iv.Y(i-1))-dpy[i-1])/(2.0-cpy[i-1]); 
+            dpy[i] = (3.0*(iv.Y(i)-iv.Y(i-1))-dpy[i-1])/(2.0-cpy[i-1]);
         }
     }
 
@@ -274,7 +263,7 @@ InputVector CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, b
     //This obtains the value of the derivative of the interpolation curve at each point.
     if(nPoints > 0) {
         //In the modified algorithm, the first and last splines are lines which are already known
-        //so we don't need to solve for them.  
+        //so we don't need to solve for them.
         unsigned int i = (mod==true) ? nPoints-2 : nPoints-1;
         Dx[i] = dpx[i];
         Dy[i] = dpy[i];
@@ -286,8 +275,10 @@ InputVector CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, b
     }
 
     //Create the new interpolated vector
-    InputVector newiv;
-    newiv.AddPoint(iv.X(0), iv.Y(0), iv.T(0));
+    InputVector& newiv = LocalScratch().combined;
+    newiv.Clear();
+    newiv.Reserve(Nsteps);
+    newiv.Append(iv.X(0), iv.Y(0), iv.T(0));
     const double start_time = iv.T(0), end_time = iv.T(-1);
     const double total_time = end_time - start_time;
     unsigned int lower = 0;
@@ -302,149 +293,186 @@ InputVector CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, b
 
 
         double current_x, current_y;
-        if((lower == 0 || upper == Nsteps-1) && mod) {
+        //the first and last splines are the straight lines, whose derivatives were never solved for
+        if((lower == 0 || upper == nPoints-1) && mod) {
             current_x = iv.X(lower) + (iv.X(upper)-iv.X(lower))*t;
             current_y = iv.Y(lower) + (iv.Y(upper)-iv.Y(lower))*t;
         }
-        else { 
+        else {
             current_x = iv.X(lower) + Dx[lower]*t + (3*(iv.X(upper)-iv.X(lower))-2*Dx[lower]-Dx[upper])*pow(t,2) +
                 (2*(iv.X(lower)-iv.X(upper))+Dx[lower]+Dx[upper])*pow(t,3);
-            current_y = iv.Y(lower) + Dy[lower]*t + (3*(iv.Y(upper)-iv.Y(lower))-2*Dy[lower]-Dy[upper])*pow(t,2) + 
-                (2*(iv.Y(lower)-iv.Y(upper))+Dy[lower]+Dy[upper])*pow(t,3);            
+            current_y = iv.Y(lower) + Dy[lower]*t + (3*(iv.Y(upper)-iv.Y(lower))-2*Dy[lower]-Dy[upper])*pow(t,2) +
+                (2*(iv.Y(lower)-iv.Y(upper))+Dy[lower]+Dy[upper])*pow(t,3);
         }
 
-        newiv.AddPoint(current_x, current_y, current_time);
+        newiv.Append(current_x, current_y, current_time);
     }
     if(Nsteps > 1) {
-        newiv.AddPoint(iv.X(-1), iv.Y(-1), iv.T(-1));
+        newiv.Append(iv.X(-1), iv.Y(-1), iv.T(-1));
     }
 
-    return SpatialInterpolation(newiv, Nsteps);
+    SpatialInterpolation(newiv, Nsteps, out);
 }
 
 
-//Normal cubic spline interplation using the triangular matrix algorithm, should be 
+//Normal cubic spline interplation using the triangular matrix algorithm, should be
 //identical to the hermite cubic spline algorithm
-InputVector CubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
-    return CubicSplineInterpolationBase(iv, Nsteps, false);
+void CubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
+    CubicSplineInterpolationBase(iv, Nsteps, false, out);
 }
 
 
 //Modified cubic spline interpolation.  The first and last splines are constrained
 //to be straight lines, the points between are interpollated with a cubic spline.
-InputVector ModCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
+void ModCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
     if(iv.Length()==3)
-        return CubicSplineInterpolationBase(iv, Nsteps, false);
+        CubicSplineInterpolationBase(iv, Nsteps, false, out);
     else
-        return CubicSplineInterpolationBase(iv, Nsteps, true);
+        CubicSplineInterpolationBase(iv, Nsteps, true, out);
 }
 
 
 //Quadratic bezier interpollation (version 2)
-InputVector BezierInterpolation(InputVector& iv, unsigned int Nsteps) {
+void BezierInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
     const unsigned int nPoints = iv.Length();
     const unsigned int nBezPoints = 3*nPoints - 4;
 
     //No fancy interpolation necessary for one or two letter words
-    if (nPoints <= 2)
-        return SpatialInterpolation(iv,Nsteps);
+    if (nPoints <= 2) {
+        SpatialInterpolation(iv,Nsteps,out);
+        return;
+    }
 
     //Create a new input vector with the bezier control points included
-    InputVector bezIV;
+    Scratch& scratch = LocalScratch();
+    InputVector& bezIV = scratch.control;
+    bezIV.Clear();
+    bezIV.Reserve(nBezPoints);
 
-    bezIV.AddPoint(iv.X(0),iv.Y(0),iv.T(0));
+    bezIV.Append(iv.X(0),iv.Y(0),iv.T(0));
     for(unsigned int i = 1; i < nPoints-1; i++) {
-        bezIV.AddPoint(iv.X(i)-(iv.X(i)-iv.X(i-1))/4,iv.Y(i)-(iv.Y(i)-iv.Y(i-1))/4,iv.T(i)-(iv.T(i)-iv.T(i-1))/4);
-        bezIV.AddPoint(iv.X(i),iv.Y(i),iv.T(i));
-        bezIV.AddPoint(iv.X(i)+(iv.X(i+1)-iv.X(i))/4,iv.Y(i)+(iv.Y(i+1)-iv.Y(i))/4,iv.T(i)+(iv.T(i+1)-iv.T(i))/4);
+        bezIV.Append(iv.X(i)-(iv.X(i)-iv.X(i-1))/4,iv.Y(i)-(iv.Y(i)-iv.Y(i-1))/4,iv.T(i)-(iv.T(i)-iv.T(i-1))/4);
+        bezIV.Append(iv.X(i),iv.Y(i),iv.T(i));
+        bezIV.Append(iv.X(i)+(iv.X(i+1)-iv.X(i))/4,iv.Y(i)+(iv.Y(i+1)-iv.Y(i))/4,iv.T(i)+(iv.T(i+1)-iv.T(i))/4);
     }
-    bezIV.AddPoint(iv.X(nPoints-1),iv.Y(nPoints-1),iv.T(nPoints-1));
-
-    //Create a list of input vectors corresponding to the different segments of the swype pattern.
-    //These will all be combined in end to form the final swype pattern
-    std::vector<InputVector> IVlist;
+    bezIV.Append(iv.X(nPoints-1),iv.Y(nPoints-1),iv.T(nPoints-1));
 
-    //The first segmens is just a straight line
-    InputVector firstSeg;
-    firstSeg.AddPoint(bezIV.X(0), bezIV.Y(0), bezIV.T(0));
-    firstSeg.AddPoint(bezIV.X(1), bezIV.Y(1), bezIV.T(1));
-    IVlist.push_back(firstSeg);
+    //The segments of the swype pattern go straight onto the end of one continuous vector, each
+    //starting where the last one ended.  The first segment is just a straight line.
+    InputVector& combinedIV = scratch.combined;
+    combinedIV.Clear();
+    combinedIV.Append(bezIV.X(0), bezIV.Y(0), bezIV.T(0));
+    combinedIV.Append(bezIV.X(1), bezIV.Y(1), bezIV.T(1));
 
-    //Create and add the quadratic bezier interpolated input vectors that form the middle section of the swype pattern
+    //Add the quadratic bezier interpolated segments that form the middle section of the swype pattern
+    const double bezLength = bezIV.SpatialLength();
     for(unsigned int i = 2; i < nBezPoints; i+=3) {
-        //Create the next input vector segment to be bezier interpolated
-        InputVector bezSeg;
-        bezSeg.AddPoint(bezIV.X(i-1),bezIV.Y(i-1),bezIV.T(i-1));
-        bezSeg.AddPoint(bezIV.X(i),bezIV.Y(i),bezIV.T(i));
-        bezSeg.AddPoint(bezIV.X(i+1),bezIV.Y(i+1),bezIV.T(i+1));
-
-        int nSegSteps = int(Nsteps*((1.5*DistanceToNextPoint(bezIV,i-1))/bezIV.SpatialLength()));
-        IVlist.push_back(QuadraticBezierInterpolation(bezSeg,nSegSteps));
-
-        //Create the next linear segment that connects neighboring bezier segments
-        InputVector linSeg;
-        linSeg.AddPoint(bezIV.X(i+1),bezIV.Y(i+1),bezIV.T(i+1));
-        linSeg.AddPoint(bezIV.X(i+2),bezIV.Y(i+2),bezIV.T(i+2));
-        IVlist.push_back(linSeg);
+        int nSegSteps = int(Nsteps*((1.5*DistanceToNextPoint(bezIV,i-1))/bezLength));
+        QuadraticBezierInterpolation(bezIV, i-1, nSegSteps, combinedIV, true);
+
+        //The next linear segment connects neighboring bezier segments
+        combinedIV.Append(bezIV.X(i+2),bezIV.Y(i+2),bezIV.T(i+2));
     }
 
-    //Combine all of the segments into one input vector
-    InputVector combinedIV;
-    combinedIV = CombineInputVectors(IVlist);
-    return SpatialInterpolation(combinedIV,Nsteps);
+    SpatialInterpolation(combinedIV,Nsteps,out);
 }
 
 
 //Very similar to the quadratic bezier interpolation algorith above.  The only difference is that
 //the control points here are halfway between each letter.
-InputVector BezierSloppyInterpolation(InputVector& iv, unsigned int Nsteps) {
+void BezierSloppyInterpolation(InputVector& iv, unsigned int Nsteps, InputVector& out) {
     const unsigned int nPoints = iv.Length();
     const unsigned int nBezPoints = 2*nPoints - 1;
 
     //No fancy interpolation necessary for one or two letter words
-    if (nPoints <= 2)
-        return SpatialInterpolation(iv,Nsteps);
+    if (nPoints <= 2) {
+        SpatialInterpolation(iv,Nsteps,out);
+        return;
+    }
 
     //Create a new input vector with the bezier control points included
-    InputVector bezIV;
+    Scratch& scratch = LocalScratch();
+    InputVector& bezIV = scratch.control;
+    bezIV.Clear();
+    bezIV.Reserve(nBezPoints);
 
-    bezIV.AddPoint(iv.X(0),iv.Y(0),iv.T(0));
+    bezIV.Append(iv.X(0),iv.Y(0),iv.T(0));
     for(unsigned int i = 1; i < nPoints; i++) {
-        bezIV.AddPoint((iv.X(i)+iv.X(i-1))/2.0,(iv.Y(i)+iv.Y(i-1))/2.0,(iv.T(i)+iv.T(i-1))/2.0);
-        bezIV.AddPoint(iv.X(i),iv.Y(i),iv.T(i));
+        bezIV.Append((iv.X(i)+iv.X(i-1))/2.0,(iv.Y(i)+iv.Y(i-1))/2.0,(iv.T(i)+iv.T(i-1))/2.0);
+        bezIV.Append(iv.X(i),iv.Y(i),iv.T(i));
     }
 
-    //Create a list to hold the input veectors corresponding to various segments of the swype pattern
-    std::vector<InputVector> IVlist;
+    //The segments go straight onto the end of one continuous vector, the first is just a straight line
+    InputVector& combinedIV = scratch.combined;
+    combinedIV.Clear();
+    combinedIV.Append(bezIV.X(0), bezIV.Y(0), bezIV.T(0));
+    combinedIV.Append(bezIV.X(1), bezIV.Y(1), bezIV.T(1));
 
-    //The first segmens is just a straight line
-    InputVector firstSeg;
-    firstSeg.AddPoint(bezIV.X(0), bezIV.Y(0), bezIV.T(0));
-    firstSeg.AddPoint(bezIV.X(1), bezIV.Y(1), bezIV.T(1));
-    IVlist.push_back(firstSeg);
-
-    //Create and add the quadratic bezier interpolated input vectors that form the middle section of the swype pattern
+    //Add the quadratic bezier interpolated segments that form the middle section of the swype pattern
+    const double bezLength = bezIV.SpatialLength();
     for(unsigned int i = 2; i < nBezPoints-1; i+=2) {
-        //Create the next input vector segment to be bezier interpolated
-        InputVector bezSeg;
-        bezSeg.AddPoint(bezIV.X(i-1),bezIV.Y(i-1),bezIV.T(i-1));
-        bezSeg.AddPoint(bezIV.X(i),bezIV.Y(i),bezIV.T(i));
-        bezSeg.AddPoint(bezIV.X(i+1),bezIV.Y(i+1),bezIV.T(i+1));
-
-        int nSegSteps = int(Nsteps*((1.5*DistanceToNextPoint(bezIV,i-1))/bezIV.SpatialLength()));
-        IVlist.push_back(QuadraticBezierInterpolation(bezSeg,nSegSteps));
+        int nSegSteps = int(Nsteps*((1.5*DistanceToNextPoint(bezIV,i-1))/bezLength));
+        QuadraticBezierInterpolation(bezIV, i-1, nSegSteps, combinedIV, true);
     }
 
     //The final segment is also just a straight line
-    InputVector lastSeg;
-    lastSeg.AddPoint(bezIV.X(bezIV.Length()-2),bezIV.Y(bezIV.Length()-2),bezIV.T(bezIV.Length()-2));
-    lastSeg.AddPoint(bezIV.X(bezIV.Length()-1),bezIV.Y(bezIV.Length()-1),bezIV.T(bezIV.Length()-1));
-    IVlist.push_back(lastSeg);
-
-    //Combine all of the segments into a single input vector
-    InputVector combinedIV;
-    combinedIV = CombineInputVectors(IVlist);
-    return SpatialInterpolation(combinedIV,Nsteps);
+    combinedIV.Append(bezIV.X(bezIV.Length()-1),bezIV.Y(bezIV.Length()-1),bezIV.T(bezIV.Length()-1));
+
+    SpatialInterpolation(combinedIV,Nsteps,out);
+}
+
+
+//The versions that return a new vector
+InputVector SpatialInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    SpatialInterpolation(iv, Nsteps, out);
+    return out;
+}
+
+InputVector HermiteCubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool monotonic) {
+    InputVector out;
+    HermiteCubicSplineInterpolationBase(iv, Nsteps, monotonic, out);
+    return out;
 }
 
+InputVector HermiteCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    HermiteCubicSplineInterpolation(iv, Nsteps, out);
+    return out;
+}
+
+InputVector MonotonicCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    MonotonicCubicSplineInterpolation(iv, Nsteps, out);
+    return out;
+}
 
+InputVector CubicSplineInterpolationBase(InputVector& iv, unsigned int Nsteps, bool mod) {
+    InputVector out;
+    CubicSplineInterpolationBase(iv, Nsteps, mod, out);
+    return out;
+}
+
+InputVector CubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    CubicSplineInterpolation(iv, Nsteps, out);
+    return out;
+}
+
+InputVector ModCubicSplineInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    ModCubicSplineInterpolation(iv, Nsteps, out);
+    return out;
+}
+
+InputVector BezierInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    BezierInterpolation(iv, Nsteps, out);
+    return out;
+}
+
+InputVector BezierSloppyInterpolation(InputVector& iv, unsigned int Nsteps) {
+    InputVector out;
+    BezierSloppyInterpolation(iv, Nsteps, out);
+    return out;
+}
@@ -0,0 +1,278 @@
+#include "InputModels/MultilayerPerceptron.h"
+#include "Hashing.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdio.h>
+#include <string.h>
+#include "math.h"
+
+using namespace std;
+
+namespace {
+    //activation function ids as written by fann_save
+    enum Activation {
+        LINEAR = 0, THRESHOLD, THRESHOLD_SYMMETRIC, SIGMOID, SIGMOID_STEPWISE, SIGMOID_SYMMETRIC,
+        SIGMOID_SYMMETRIC_STEPWISE, GAUSSIAN, GAUSSIAN_SYMMETRIC, GAUSSIAN_STEPWISE, ELLIOT, ELLIOT_SYMMETRIC,
+        LINEAR_PIECE, LINEAR_PIECE_SYMMETRIC, SIN_SYMMETRIC, COS_SYMMETRIC, SIN, COS, ACTIVATIONS
+    };
+
+    //the text following "key=" up to the end of its line
+    bool FindValue(const string& text, const char* key, string& value) {
+        size_t position = text.find(string("\n") + key + "=");
+        if(position == string::npos) return false;
+        position += strlen(key) + 2;
+        value = text.substr(position, text.find('\n', position) - position);
+        return true;
+    }
+};
+
+const unsigned int MultilayerPerceptron::block;
+
+MultilayerPerceptron::MultilayerPerceptron() {
+    neurons = inputs = outputs = 0;
+    input_bias = output_first = 0;
+}
+
+bool MultilayerPerceptron::Load(const char *filename) {
+    layers.clear();
+    neurons = inputs = outputs = 0;
+
+    ifstream file(filename);
+    if(!file) {
+        cerr << "ERROR: Unable to open the network file " << filename << "." << endl;
+        return false;
+    }
+    stringstream buffer;
+    buffer << file.rdbuf();
+    const string text = buffer.str();
+    if(text.compare(0, 8, "FANN_FLO") != 0) {
+        cerr << "ERROR: " << filename << " is not a floating point FANN network file." << endl;
+        return false;
+    }
+
+    string value;
+    unsigned int network_type = 0;
+    if(FindValue(text, "network_type", value)) {
+        network_type = atoi(value.c_str());
+    }
+
+    vector<unsigned int> layer_sizes;
+    if(FindValue(text, "layer_sizes", value)) {
+        istringstream sizes(value);
+        unsigned int size;
+        while(sizes >> size) layer_sizes.push_back(size);
+    }
+    if(layer_sizes.size() < 2) {
+        cerr << "ERROR: " << filename << " doesn't describe at least two layers." << endl;
+        return false;
+    }
+
+    vector<unsigned int> layer_first(1, 0);
+    for(unsigned int l = 0; l < layer_sizes.size(); l++) {
+        layer_first.push_back(layer_first.back() + layer_sizes[l]);
+    }
+    const unsigned int total = layer_first.back();
+
+    //(num_inputs, activation_function, activation_steepness) for every neuron in order
+    vector<unsigned int> connections(total), activation(total);
+    vector<float> steepness(total);
+    if(!FindValue(text, "neurons (num_inputs, activation_function, activation_steepness)", value)) value.clear();
+    const char *cursor = value.c_str();
+    unsigned int total_connections = 0;
+    for(unsigned int n = 0; n < total; n++) {
+        int consumed = 0;
+        if(sscanf(cursor, " (%u, %u, %f)%n", &connections[n], &activation[n], &steepness[n], &consumed) != 3) {
+            cerr << "ERROR: " << filename << " lists fewer neurons than its layer sizes require." << endl;
+            return false;
+        }
+        if(activation[n] >= ACTIVATIONS) {
+            cerr << "ERROR: Unknown activation function " << activation[n] << " in " << filename << "." << endl;
+            return false;
+        }
+        cursor += consumed;
+        total_connections += connections[n];
+    }
+
+    //(connected_to_neuron, weight) for each connection, grouped by the neuron they feed
+    vector<unsigned int> targets(total_connections);
+    vector<float> weights(total_connections);
+    if(!FindValue(text, "connections (connected_to_neuron, weight)", value)) value.clear();
+    cursor = value.c_str();
+    for(unsigned int c = 0; c < total_connections; c++) {
+        int consumed = 0;
+        if(sscanf(cursor, " (%u, %f)%n", &targets[c], &weights[c], &consumed) != 2) {
+            cerr << "ERROR: " << filename << " lists fewer connections than its neurons require." << endl;
+            return false;
+        }
+        cursor += consumed;
+    }
+
+    //input neurons have no connections so the first layer's start at zero
+    unsigned int c = 0;
+    for(unsigned int l = 1; l < layer_sizes.size(); l++) {
+        Layer layer;
+        layer.first = layer_first[l];
+        layer.count = layer_sizes[l];
+        unsigned int low = total, high = 0;
+        for(unsigned int n = layer.first, k = c; n < layer.first + layer.count; n++) {
+            for(unsigned int end = k + connections[n]; k < end; k++) {
+                if(targets[k] >= layer.first) {
+                    cerr << "ERROR: " << filename << " isn't a feed-forward network." << endl;
+                    layers.clear();
+                    return false;
+                }
+                low = min(low, targets[k]);
+                high = max(high, targets[k]);
+            }
+        }
+        layer.source_first = low < high + 1 ? low : 0;
+        layer.sources = low < high + 1 ? high + 1 - low : 0;
+        layer.weights.assign(layer.count*layer.sources, 0);
+        for(unsigned int n = layer.first; n < layer.first + layer.count; n++) {
+            float *row = layer.sources > 0 ? &layer.weights[(n - layer.first)*layer.sources] : 0;
+            for(unsigned int end = c + connections[n]; c < end; c++) {
+                row[targets[c] - layer.source_first] += weights[c];
+            }
+            layer.activation.push_back(activation[n]);
+            layer.steepness.push_back(steepness[n]);
+            layer.bias.push_back(connections[n] == 0);
+        }
+        layers.push_back(layer);
+    }
+
+    neurons = total;
+    //there is always a bias neuron at the end of the input layer, and at the end of the output layer
+    //for layered (as opposed to shortcut) networks
+    inputs = layer_sizes[0] - 1;
+    input_bias = inputs;
+    output_first = layer_first[layer_sizes.size()-1];
+    outputs = layer_sizes.back() - (network_type == 0 ? 1 : 0);
+    return true;
+}
+
+void MultilayerPerceptron::Activate(const Layer& layer, unsigned int n, float* sums, unsigned int rows) const {
+    //fann scales by the steepness and then clamps to +/-150/steepness
+    const float steepness = layer.steepness[n];
+    const float limit = steepness != 0 ? fabs(150.0f/steepness) : 150.0f;
+    for(unsigned int r = 0; r < rows; r++) {
+        sums[r] = min(max(steepness*sums[r], -limit), limit);
+    }
+
+    float *v = sums;
+    switch(layer.activation[n]) {
+        case LINEAR:
+            break;
+        case THRESHOLD:
+            for(unsigned int r = 0; r < rows; r++) v[r] = v[r] < 0 ? 0.0f : 1.0f;
+            break;
+        case THRESHOLD_SYMMETRIC:
+            for(unsigned int r = 0; r < rows; r++) v[r] = v[r] < 0 ? -1.0f : 1.0f;
+            break;
+        //the stepwise variants are fann's piecewise linear approximations of the exact sigmoids
+        case SIGMOID:
+        case SIGMOID_STEPWISE:
+            for(unsigned int r = 0; r < rows; r++) v[r] = 1.0f/(1.0f + exp(-2.0f*v[r]));
+            break;
+        case SIGMOID_SYMMETRIC:
+        case SIGMOID_SYMMETRIC_STEPWISE:
+            for(unsigned int r = 0; r < rows; r++) v[r] = 2.0f/(1.0f + exp(-2.0f*v[r])) - 1.0f;
+            break;
+        case GAUSSIAN:
+            for(unsigned int r = 0; r < rows; r++) v[r] = exp(-v[r]*v[r]);
+            break;
+        case GAUSSIAN_SYMMETRIC:
+            for(unsigned int r = 0; r < rows; r++) v[r] = 2.0f*exp(-v[r]*v[r]) - 1.0f;
+            break;
+        case GAUSSIAN_STEPWISE:
+            //fann never implemented this one and always outputs zero
+            for(unsigned int r = 0; r < rows; r++) v[r] = 0;
+            break;
+        case ELLIOT:
+            for(unsigned int r = 0; r < rows; r++) v[r] = 0.5f*v[r]/(1.0f + fabs(v[r])) + 0.5f;
+            break;
+        case ELLIOT_SYMMETRIC:
+            for(unsigned int r = 0; r < rows; r++) v[r] = v[r]/(1.0f + fabs(v[r]));
+            break;
+        case LINEAR_PIECE:
+            for(unsigned int r = 0; r < rows; r++) v[r] = min(max(v[r], 0.0f), 1.0f);
+            break;
+        case LINEAR_PIECE_SYMMETRIC:
+            for(unsigned int r = 0; r < rows; r++) v[r] = min(max(v[r], -1.0f), 1.0f);
+            break;
+        case SIN_SYMMETRIC:
+            for(unsigned int r = 0; r < rows; r++) v[r] = sin(v[r]);
+            break;
+        case COS_SYMMETRIC:
+            for(unsigned int r = 0; r < rows; r++) v[r] = cos(v[r]);
+            break;
+        case SIN:
+            for(unsigned int r = 0; r < rows; r++) v[r] = 0.5f*sin(v[r]) + 0.5f;
+            break;
+        case COS:
+            for(unsigned int r = 0; r < rows; r++) v[r] = 0.5f*cos(v[r]) + 0.5f;
+            break;
+    }
+}
+
+void MultilayerPerceptron::RunBatch(const float* in, unsigned int rows, float* out) const {
+    if(Empty()) {
+        fill(out, out + rows*outputs, 0.0f);
+        return;
+    }
+
+    //neuron-major so that every inner loop runs over contiguous rows of the block
+    vector<float> values(neurons*block);
+    for(unsigned int start = 0; start < rows; start += block) {
+        const unsigned int n = min(block, rows - start);
+        for(unsigned int i = 0; i < inputs; i++) {
+            float *v = &values[i*block];
+            for(unsigned int r = 0; r < n; r++) v[r] = in[(start + r)*inputs + i];
+        }
+        fill(&values[input_bias*block], &values[input_bias*block] + n, 1.0f);
+
+        for(unsigned int l = 0; l < layers.size(); l++) {
+            const Layer& layer = layers[l];
+            for(unsigned int o = 0; o < layer.count; o++) {
+                float *v = &values[(layer.first + o)*block];
+                if(layer.bias[o]) {
+                    fill(v, v + n, 1.0f);
+                    continue;
+                }
+                fill(v, v + n, 0.0f);
+                const float *w = &layer.weights[o*layer.sources];
+                for(unsigned int s = 0; s < layer.sources; s++) {
+                    if(w[s] == 0) continue;
+                    const float weight = w[s];
+                    const float *source = &values[(layer.source_first + s)*block];
+                    for(unsigned int r = 0; r < n; r++) v[r] += weight*source[r];
+                }
+                Activate(layer, o, v, n);
+            }
+        }
+
+        for(unsigned int j = 0; j < outputs; j++) {
+            const float *v = &values[(output_first + j)*block];
+            for(unsigned int r = 0; r < n; r++) out[(start + r)*outputs + j] = v[r];
+        }
+    }
+}
+
+uint64_t MultilayerPerceptron::Fingerprint() const {
+    uint64_t h = HashCombine(HashMix(neurons), inputs);
+    h = HashCombine(h, outputs);
+    for(unsigned int l = 0; l < layers.size(); l++) {
+        const Layer& layer = layers[l];
+        h = HashCombine(h, HashCombine(HashMix(layer.first), layer.count));
+        h = HashCombine(h, HashCombine(HashMix(layer.source_first), layer.sources));
+        if(layer.weights.size() > 0) h = HashCombine(h, HashBytes((const char*) &layer.weights[0], layer.weights.size()*sizeof(float)));
+        for(unsigned int n = 0; n < layer.count; n++) {
+            h = HashCombine(h, HashCombine(HashMix(layer.activation[n]), layer.bias[n]));
+            h = HashCombine(h, HashDouble(layer.steepness[n]));
+        }
+    }
+    return h;
+}
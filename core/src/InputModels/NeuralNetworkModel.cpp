@@ -1,23 +1,75 @@
 #include "InputModels/NeuralNetworkModel.h"
 
 #include "InputModels/InputVector.h"
-
-#include "fann.h"
+#include "FrozenWordList.h"
+#include "Hashing.h"
+#include "Instrumentation.h"
 
 #include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
 #include "math.h"
 using namespace std;
 
-NeuralNetworkModel::NeuralNetworkModel() {}
+void CandidateFeatures::Build(InputVector* vectors, unsigned int n) {
+    candidates = n;
+    points = n > 0 ? vectors[0].Length() : 0;
+    x.resize(points*n); y.resize(points*n);
+    dx.resize((points-1)*n); dy.resize((points-1)*n);
+    ddx.resize((points-2)*n); ddy.resize((points-2)*n);
+    length.assign(n, 0);
+    for(unsigned int c = 0; c < n; c++) {
+        InputVector& v = vectors[c];
+        double lastdx = 0, lastdy = 0, l = 0;
+        for(unsigned int i = 0; i < points; i++) {
+            x[i*n + c] = v.X(i);
+            y[i*n + c] = v.Y(i);
+            if(i == 0) continue;
+            const double newdx = v.X(i) - v.X(i-1);
+            const double newdy = v.Y(i) - v.Y(i-1);
+            dx[(i-1)*n + c] = newdx;
+            dy[(i-1)*n + c] = newdy;
+            if(i > 1) {
+                ddx[(i-2)*n + c] = newdx - lastdx;
+                ddy[(i-2)*n + c] = newdy - lastdy;
+            }
+            l += sqrt(newdx*newdx + newdy*newdy);
+            lastdx = newdx;
+            lastdy = newdy;
+        }
+        length[c] = l;
+    }
+}
+
+NeuralNetworkModel::NeuralNetworkModel() { candidates_key = 0; }
 
 NeuralNetworkModel::NeuralNetworkModel(const char *filename, unsigned int vector_length, double xscale, double yscale, double correlation, double maxdistance, double maxsigmas, bool loop) :
     SimpleInterpolationModel(vector_length, xscale, yscale, correlation, maxdistance, maxsigmas, loop) {
 
-    ann = fann_create_from_file(filename);
+    candidates_key = 0;
+    if(!SetANN(filename)) {
+        throw runtime_error(string("Unable to load a network for NeuralNetworkModel from ") + filename);
+    }
+}
+
+bool NeuralNetworkModel::SetANN(const char *filename) {
+    MultilayerPerceptron loaded;
+    if(!loaded.Load(filename)) {
+        return false;
+    }
+    //Run writes Outputs() floats from input_length of them
+    if(loaded.Inputs() != input_length || loaded.Outputs() != 1) {
+        cerr << "ERROR: " << filename << " has " << loaded.Inputs() << " inputs and " << loaded.Outputs()
+             << " outputs but NeuralNetworkModel needs " << input_length << " and 1." << endl;
+        return false;
+    }
+    network = loaded;
+    return true;
 }
 
-void NeuralNetworkModel::SetANN(const char *filename) {
-    ann = fann_create_from_file(filename);
+uint64_t NeuralNetworkModel::Fingerprint() const {
+    return HashCombine(HashCombine(HashString("NeuralNetworkModel"), SimpleInterpolationModel::Fingerprint()), network.Fingerprint());
 }
 
 // ==  The meaning of each entry in inputs is as follows:
@@ -85,8 +137,150 @@ void NeuralNetworkModel::CreateInputs(InputVector& v1, InputVector& v2, float* i
     inputs[10] = pow(v2.Y(-1) - v1.Y(-1), 2);
 }
 
-double NeuralNetworkModel::VectorDistance(InputVector& vector1, InputVector& vector2) {
+double NeuralNetworkModel::VectorDistance(InputVector& vector1, InputVector& vector2) const {
+    DODONA_TIME(VectorDistance);
     float inputs[11];
+    float output = 0;
     CreateInputs(vector1, vector2, inputs);
-    return 1.0 - double(*fann_run(ann, inputs));
+    network.Run(inputs, &output);
+    return 1.0 - double(output);
+}
+
+void NeuralNetworkModel::CreateInputsBatch(InputVector& v, const CandidateFeatures& c, float* inputs) {
+    const unsigned int n = c.candidates, points = c.points;
+
+    //the sample's own terms, in the same form as the candidates'
+    vector<float> sx(points), sy(points), sdx(points), sdy(points), sddx(points), sddy(points);
+    double length = 0, lastdx = 0, lastdy = 0;
+    for(unsigned int i = 0; i < points; i++) {
+        sx[i] = v.X(i);
+        sy[i] = v.Y(i);
+        if(i == 0) continue;
+        const double newdx = v.X(i) - v.X(i-1);
+        const double newdy = v.Y(i) - v.Y(i-1);
+        sdx[i-1] = newdx;
+        sdy[i-1] = newdy;
+        if(i > 1) {
+            sddx[i-2] = newdx - lastdx;
+            sddy[i-2] = newdy - lastdy;
+        }
+        length += sqrt(newdx*newdx + newdy*newdy);
+        lastdx = newdx;
+        lastdy = newdy;
+    }
+
+    //accumulate feature-major, then transpose into rows at the end
+    vector<float> features(input_length*n, 0.0f);
+    float *f1 = &features[1*n], *f2 = &features[2*n], *f3 = &features[3*n];
+    float *f4 = &features[4*n], *f5 = &features[5*n], *f6 = &features[6*n];
+    for(unsigned int i = 0; i < points; i++) {
+        const float *cx = &c.x[i*n], *cy = &c.y[i*n];
+        const float px = sx[i], py = sy[i];
+        for(unsigned int k = 0; k < n; k++) {
+            const float ex = cx[k] - px, ey = cy[k] - py;
+            f1[k] += ex*ex;
+            f2[k] += ey*ey;
+        }
+    }
+    for(unsigned int i = 0; i + 1 < points; i++) {
+        const float *cx = &c.dx[i*n], *cy = &c.dy[i*n];
+        const float px = sdx[i], py = sdy[i];
+        for(unsigned int k = 0; k < n; k++) {
+            const float ex = cx[k] - px, ey = cy[k] - py;
+            f3[k] += ex*ex;
+            f4[k] += ey*ey;
+        }
+    }
+    for(unsigned int i = 0; i + 2 < points; i++) {
+        const float *cx = &c.ddx[i*n], *cy = &c.ddy[i*n];
+        const float px = sddx[i], py = sddy[i];
+        for(unsigned int k = 0; k < n; k++) {
+            const float ex = cx[k] - px, ey = cy[k] - py;
+            f5[k] += ex*ex;
+            f6[k] += ey*ey;
+        }
+    }
+
+    const unsigned int last = points - 1;
+    for(unsigned int k = 0; k < n; k++) {
+        float *row = &inputs[k*input_length];
+        row[0] = fabs(c.length[k] - length);
+        if(c.length[k] > 0 || length > 0) { row[0] /= max(double(c.length[k]), length); }
+        for(unsigned int j = 1; j < 7; j++) row[j] = features[j*n + k];
+        row[7] = pow(c.x[k] - sx[0], 2);
+        row[8] = pow(c.y[k] - sy[0], 2);
+        row[9] = pow(c.x[last*n + k] - sx[last], 2);
+        row[10] = pow(c.y[last*n + k] - sy[last], 2);
+    }
+}
+
+void NeuralNetworkModel::VectorDistanceBatch(InputVector& iv, InputVector* vectors, unsigned int n, double* distances) const {
+    DODONA_COUNT(VectorDistance, n);
+    //build every feature row first so the network sees the whole batch at once
+    vector<float> inputs(n*input_length), outputs(n);
+    bool uniform = iv.Length() >= 2;
+    for(unsigned int i = 0; i < n && uniform; i++) {
+        uniform = vectors[i].Length() == iv.Length();
+    }
+    if(uniform) {
+        CandidateFeatures features;
+        features.Build(vectors, n);
+        CreateInputsBatch(iv, features, inputs.size() > 0 ? &inputs[0] : 0);
+    }
+    else {
+        for(unsigned int i = 0; i < n; i++) {
+            CreateInputs(iv, vectors[i], &inputs[i*input_length]);
+        }
+    }
+    if(n > 0) network.RunBatch(&inputs[0], n, &outputs[0]);
+    for(unsigned int i = 0; i < n; i++) {
+        distances[i] = 1.0 - double(outputs[i]);
+    }
+}
+
+template<typename Words> void NeuralNetworkModel::UpdateCandidates(Keyboard& k, Words& w) const {
+    const uint64_t key = HashCombine(HashCombine(k.Hash(), w.Fingerprint()), PerfectSettingsHash());
+    if(key == candidates_key && candidates.candidates == w.Words()) return;
+
+    vector<InputVector> perfect(w.Words());
+    for(unsigned int i = 0; i < w.Words(); i++) {
+        ReferenceVector(w.Word(i), k, perfect[i]);
+    }
+    candidates.Build(&perfect[0], perfect.size());
+    candidates_key = key;
+}
+
+template<typename Words> const char* NeuralNetworkModel::ClosestCandidate(InputVector& vector, Keyboard& k, Words& w) const {
+    //the max sigma cut is made word by word inside Distance so that case stays on the generic path
+    if(MaxSigmas() > 0 || network.Empty() || w.Words() == 0 || VectorLength() < 2 || vector.Length() != VectorLength()) {
+        return InputModel::BestMatch(vector, k, w);
+    }
+
+    UpdateCandidates(k, w);
+    const unsigned int n = candidates.candidates;
+    DODONA_COUNT(BestMatchCandidates, n);
+    std::vector<float> inputs(n*input_length), outputs(n);
+    CreateInputsBatch(vector, candidates, &inputs[0]);
+    network.RunBatch(&inputs[0], n, &outputs[0]);
+
+    //same tie breaking as InputModel::BestMatch: the first word with the lowest distance
+    unsigned int best = 0;
+    double best_distance = 1.0 - double(outputs[0]);
+    for(unsigned int i = 1; i < n; i++) {
+        const double distance = 1.0 - double(outputs[i]);
+        if(distance < best_distance) {
+            best = i;
+            best_distance = distance;
+        }
+    }
+    return w.Word(best);
+}
+
+const char* NeuralNetworkModel::BestMatch(InputVector& vector, Keyboard& k, WordList& w) const {
+    return ClosestCandidate(vector, k, w);
+}
+
+//a snapshot has the same fingerprint as its list, so the candidates built for either serve both
+const char* NeuralNetworkModel::BestMatch(InputVector& vector, Keyboard& k, const FrozenWordList& w) const {
+    return ClosestCandidate(vector, k, w);
 }
@@ -1,9 +1,12 @@
 #include "InputModels/SimpleGaussianModel.h"
+#include "Hashing.h"
+#include "Instrumentation.h"
 #include "Keyboard.h"
 #include "Polygon.h"
 
 #include "math.h"
 #include <cctype>
+#include <vector>
 
 #include <boost/random.hpp>
 #include <boost/random/normal_distribution.hpp>
@@ -24,42 +27,68 @@ void SimpleGaussianModel::SetCorrelation(double corr) {
     correlation_complement = sqrt(1.0-correlation*correlation);
 }
 
-InputVector SimpleGaussianModel::RandomVector(const char* word, Keyboard& k) {
+InputVector SimpleGaussianModel::RandomVector(const char* word, Keyboard& k, boost::mt19937& generator) const {
+    DODONA_TIME(RandomVector);
+    InputVector sigma;
+    RandomVector(word, k, generator, sigma);
+    return sigma;
+}
+
+void SimpleGaussianModel::RandomVector(const char* word, Keyboard& k, boost::mt19937& generator, InputVector& out) const {
     //it's wasteful to remake this every time but I had trouble making it a global member
     boost::normal_distribution<> nd(0.0, 1.0);
     boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > normal(generator, nd);
 
+    //draw in the same order as OffsetVector consumes them: x then y for each letter
+    static thread_local vector<double> offsets;
+    offsets.resize(2*strlen(word));
+    for(unsigned int i = 0; i < offsets.size(); i++) {
+        offsets[i] = normal();
+    }
+    PlaceVector(word, k, offsets.size() > 0 ? &offsets[0] : 0, out);
+}
+
+InputVector SimpleGaussianModel::PlaceVector(const char* word, Keyboard& k, const double* offsets) const {
     InputVector sigma;
-    double lastx = normal(), lasty = normal();
-    for(unsigned int i = 0; i < strlen(word); i++) {
+    PlaceVector(word, k, offsets, sigma);
+    return sigma;
+}
+
+void SimpleGaussianModel::PlaceVector(const char* word, Keyboard& k, const double* offsets, InputVector& out) const {
+    out.Clear();
+    const unsigned int length = strlen(word);
+    double lastx = 0, lasty = 0;
+    for(unsigned int i = 0; i < length; i++) {
         Polygon p = k.GetKey(tolower(word[i]));
         const double t = p.TopExtreme();
         const double b = p.BottomExtreme();
         const double r = p.RightExtreme();
         const double l = p.LeftExtreme();
 
-        if(i > 0) {
-            lastx = lastx*correlation + normal()*correlation_complement;
-            lasty = lasty*correlation + normal()*correlation_complement;
+        if(offsets == 0) {
+            lastx = lasty = 0;
+        }
+        else if(i > 0) {
+            lastx = lastx*correlation + offsets[2*i]*correlation_complement;
+            lasty = lasty*correlation + offsets[2*i+1]*correlation_complement;
+        }
+        else {
+            lastx = offsets[0];
+            lasty = offsets[1];
         }
 
         const double x = lastx*xsigma*(r-l) + 0.5*(r+l);
         const double y = lasty*ysigma*(t-b) + 0.5*(t+b);
-        sigma.AddPoint(x, y, double(i));
+        out.Append(x, y, double(i));
     }
-    return sigma;
 }
 
-InputVector SimpleGaussianModel::PerfectVector(const char* word, Keyboard& k) {
-    const double tmp_xsigma = xsigma; xsigma = 0;
-    const double tmp_ysigma = ysigma; ysigma = 0;
-    InputVector sigma = RandomVector(word, k);
-    xsigma = tmp_xsigma;
-    ysigma = tmp_ysigma;
-    return sigma;
+InputVector SimpleGaussianModel::PerfectVector(const char* word, Keyboard& k) const {
+    DODONA_TIME(PerfectVector);
+    return PlaceVector(word, k, 0);
 }
 
-double SimpleGaussianModel::MarginalProbability( InputVector& sigma, const char* word, Keyboard& k) {
+double SimpleGaussianModel::MarginalProbability( InputVector& sigma, const char* word, Keyboard& k) const {
     if(sigma.Length() != strlen(word)) {
         return 0;
     }
@@ -85,7 +114,8 @@ double SimpleGaussianModel::MarginalProbability( InputVector& sigma, const char*
     return probability;
 }
 
-double SimpleGaussianModel::Distance( InputVector& sigma, const char* word, Keyboard& k) { 
+double SimpleGaussianModel::Distance( InputVector& sigma, const char* word, Keyboard& k) const {
+    DODONA_TIME(Distance);
     if(sigma.Length() != strlen(word)) {
         return 1;
     }
@@ -107,10 +137,17 @@ double SimpleGaussianModel::Distance( InputVector& sigma, const char* word, Keyb
     return (probability - MarginalProbability(sigma, word, k))/probability;
 }
 
-double SimpleGaussianModel::VectorDistance(InputVector& vector1, InputVector& vector2) {
+double SimpleGaussianModel::VectorDistance(InputVector& vector1, InputVector& vector2) const {
+    DODONA_TIME(VectorDistance);
     double d2 = 0;
     for(unsigned int i = 0; i < vector1.Length(); i++) {
         d2 += pow( vector1.X(i) - vector2.X(i), 2) + pow( vector1.Y(i) - vector2.Y(i), 2);
     }
     return sqrt(d2);
 }
+
+uint64_t SimpleGaussianModel::Fingerprint() const {
+    uint64_t h = HashCombine(HashString("SimpleGaussianModel"), HashDouble(xsigma));
+    h = HashCombine(h, HashDouble(ysigma));
+    return HashCombine(h, HashDouble(correlation));
+}
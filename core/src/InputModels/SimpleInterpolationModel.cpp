@@ -1,15 +1,29 @@
 #include "InputModels/SimpleInterpolationModel.h"
 #include "InputModels/SimpleGaussianModel.h"
 #include "InputModels/Interpolation.h"
+#include "Instrumentation.h"
 
 #include "Keyboard.h"
 #include "Polygon.h"
+#include "Hashing.h"
 
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
 
 namespace {
+    //The letter points interpolations start from and the vector Distance compares against, kept per
+    //thread so that once they have grown to fit the longest word nothing is allocated for them.
+    class Scratch {
+      public:
+        InputVector control, reference;
+    };
+
+    Scratch& LocalScratch() {
+        static thread_local Scratch scratch;
+        return scratch;
+    }
+
     void HandleDoubleLetters(InputVector &iv, const char* word, Keyboard& k, bool loop_letter) {
         const unsigned int length = strlen(word);
         unsigned int doubles = 0;
@@ -45,19 +59,37 @@ SimpleInterpolationModel::SimpleInterpolationModel(unsigned int vector_length, d
     SetCorrelation(correlation);
 }
 
-InputVector SimpleInterpolationModel::RandomVector(const char* word, Keyboard& k) {
-    InputVector iv = model.RandomVector(word, k);
-    HandleDoubleLetters(iv, word, k, loop_letter);
-    return Interpolation(iv, vlength);
+InputVector SimpleInterpolationModel::RandomVector(const char* word, Keyboard& k, boost::mt19937& generator) const {
+    DODONA_TIME(RandomVector);
+    InputVector& control = LocalScratch().control;
+    model.RandomVector(word, k, generator, control);
+    HandleDoubleLetters(control, word, k, loop_letter);
+    InputVector out;
+    Interpolation(control, vlength, out);
+    return out;
 }
 
-InputVector SimpleInterpolationModel::PerfectVector(const char* word, Keyboard& k) {
-    InputVector iv = model.PerfectVector(word, k);
-    HandleDoubleLetters(iv, word, k, loop_letter);
-    return Interpolation(iv, vlength);
+InputVector SimpleInterpolationModel::OffsetVector(const char* word, Keyboard& k, const double* offsets) const {
+    InputVector& control = LocalScratch().control;
+    model.PlaceVector(word, k, offsets, control);
+    HandleDoubleLetters(control, word, k, loop_letter);
+    InputVector out;
+    Interpolation(control, vlength, out);
+    return out;
 }
 
-double SimpleInterpolationModel::Distance( InputVector& sigma, const char* word, Keyboard& k) { 
+InputVector SimpleInterpolationModel::PerfectVector(const char* word, Keyboard& k) const {
+    DODONA_TIME(PerfectVector);
+    InputVector& control = LocalScratch().control;
+    model.PerfectVector(word, k, control);
+    HandleDoubleLetters(control, word, k, loop_letter);
+    InputVector out;
+    Interpolation(control, vlength, out);
+    return out;
+}
+
+double SimpleInterpolationModel::Distance( InputVector& sigma, const char* word, Keyboard& k) const {
+    DODONA_TIME(Distance);
     if(maxs > 0) {
         Polygon p = k.GetKey(word[0]);
         const double t = p.TopExtreme();
@@ -70,12 +102,25 @@ double SimpleInterpolationModel::Distance( InputVector& sigma, const char* word,
         }
     }
 
-    InputVector perfect = model.PerfectVector(word, k);
-    perfect = Interpolation(perfect, vlength);
-    return VectorDistance(sigma, perfect);
+    InputVector& reference = LocalScratch().reference;
+    ReferenceVector(word, k, reference);
+    return VectorDistance(sigma, reference);
 }
 
-double SimpleInterpolationModel::VectorDistance(InputVector& vector1, InputVector& vector2) {
+InputVector SimpleInterpolationModel::ReferenceVector(const char* word, Keyboard& k) const {
+    InputVector out;
+    ReferenceVector(word, k, out);
+    return out;
+}
+
+void SimpleInterpolationModel::ReferenceVector(const char* word, Keyboard& k, InputVector& out) const {
+    InputVector& control = LocalScratch().control;
+    model.PerfectVector(word, k, control);
+    Interpolation(control, vlength, out);
+}
+
+double SimpleInterpolationModel::VectorDistance(InputVector& vector1, InputVector& vector2) const {
+    DODONA_TIME(VectorDistance);
     double d2 = 0;
     for(unsigned int i = 0; i < vlength; i++) {
         d2 += pow( vector1.X(i) - vector2.X(i), 2) + pow( vector1.Y(i) - vector2.Y(i), 2);
@@ -84,11 +129,19 @@ double SimpleInterpolationModel::VectorDistance(InputVector& vector1, InputVecto
     return sqrt(d2);
 }
 
-void SimpleInterpolationModel::SetSeed(unsigned int s) {
-    generator.seed(s);
-    model.SetSeed(s);
+void SimpleInterpolationModel::Interpolation(InputVector& iv, unsigned int N, InputVector& out) const {
+    DODONA_TIME(Interpolation);
+    interpolation(iv, N, out);
+}
+
+uint64_t SimpleInterpolationModel::PerfectSettingsHash() const {
+    uint64_t h = HashCombine(HashMix(vlength), loop_letter);
+    return HashCombine(h, uint64_t(uintptr_t(interpolation)));
 }
 
-InputVector SimpleInterpolationModel::Interpolation(InputVector& iv, unsigned int N) const {
-    return interpolation(iv, N);
+uint64_t SimpleInterpolationModel::Fingerprint() const {
+    uint64_t h = HashCombine(HashString("SimpleInterpolationModel"), model.Fingerprint());
+    h = HashCombine(h, PerfectSettingsHash());
+    h = HashCombine(h, HashDouble(maxd));
+    return HashCombine(h, HashDouble(maxs));
 }
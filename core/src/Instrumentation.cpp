@@ -0,0 +1,151 @@
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const char *counter_names[Instrumentation::NCounters] = {"RandomVector", "PerfectVector", "Interpolation",
+        "Distance", "VectorDistance", "BestMatchCandidates", "RadixMatches", "UpdateVectors", "UpdateTree",
+        "Allocations"};
+};
+
+const char* Instrumentation::CounterName(unsigned int counter) {
+    return counter < NCounters ? counter_names[counter] : "";
+}
+
+Instrumentation::Stats::Stats() {
+    fill(counts, counts + NCounters, 0);
+    fill(nanoseconds, nanoseconds + NCounters, 0);
+}
+
+Instrumentation::Stats& Instrumentation::Stats::operator+=(const Stats& other) {
+    for(unsigned int c = 0; c < NCounters; c++) {
+        counts[c] += other.counts[c];
+        nanoseconds[c] += other.nanoseconds[c];
+    }
+    return *this;
+}
+
+Instrumentation::Stats Instrumentation::Stats::operator-(const Stats& other) const {
+    Stats difference;
+    for(unsigned int c = 0; c < NCounters; c++) {
+        difference.counts[c] = counts[c] - other.counts[c];
+        difference.nanoseconds[c] = nanoseconds[c] - other.nanoseconds[c];
+    }
+    return difference;
+}
+
+bool Instrumentation::Stats::Empty() const {
+    for(unsigned int c = 0; c < NCounters; c++) {
+        if(counts[c] != 0) return false;
+    }
+    return true;
+}
+
+#ifdef DODONA_INSTRUMENTATION
+
+class Instrumentation::ThreadCounters {
+  public:
+    atomic<uint64_t> counts[NCounters], nanoseconds[NCounters];
+    //subtracted when reading, so that Reset doesn't have to write to another thread's counters
+    Stats reset;
+
+    ThreadCounters();
+    ~ThreadCounters();
+    Stats Read() const {
+        Stats s;
+        for(unsigned int c = 0; c < NCounters; c++) {
+            s.counts[c] = counts[c].load(memory_order_relaxed);
+            s.nanoseconds[c] = nanoseconds[c].load(memory_order_relaxed);
+        }
+        return s;
+    }
+};
+
+namespace {
+    //the running threads' counters and what the finished ones counted
+    mutex registry_mutex;
+    vector<Instrumentation::ThreadCounters*> registry;
+    Instrumentation::Stats retired;
+};
+
+Instrumentation::ThreadCounters::ThreadCounters() {
+    for(unsigned int c = 0; c < NCounters; c++) {
+        counts[c].store(0, memory_order_relaxed);
+        nanoseconds[c].store(0, memory_order_relaxed);
+    }
+    lock_guard<mutex> lock(registry_mutex);
+    registry.push_back(this);
+}
+
+Instrumentation::ThreadCounters::~ThreadCounters() {
+    lock_guard<mutex> lock(registry_mutex);
+    retired += Read() - reset;
+    registry.erase(find(registry.begin(), registry.end(), this));
+}
+
+Instrumentation::ThreadCounters& Instrumentation::Local() {
+    static thread_local ThreadCounters local;
+    return local;
+}
+
+void Instrumentation::Add(ThreadCounters& local, Counter counter, uint64_t n, uint64_t nanoseconds) {
+    local.counts[counter].store(local.counts[counter].load(memory_order_relaxed) + n, memory_order_relaxed);
+    if(nanoseconds > 0) {
+        local.nanoseconds[counter].store(local.nanoseconds[counter].load(memory_order_relaxed) + nanoseconds, memory_order_relaxed);
+    }
+}
+
+uint64_t Instrumentation::Now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool Instrumentation::Enabled() {
+    return true;
+}
+
+Instrumentation::Stats Instrumentation::ThreadStats() {
+    //not less the reset, so that differences between two calls stay right across a Reset
+    return Local().Read();
+}
+
+Instrumentation::Stats Instrumentation::Aggregate() {
+    lock_guard<mutex> lock(registry_mutex);
+    Stats total = retired;
+    for(unsigned int t = 0; t < registry.size(); t++) {
+        total += registry[t]->Read() - registry[t]->reset;
+    }
+    return total;
+}
+
+void Instrumentation::Reset() {
+    lock_guard<mutex> lock(registry_mutex);
+    retired = Stats();
+    for(unsigned int t = 0; t < registry.size(); t++) {
+        registry[t]->reset = registry[t]->Read();
+    }
+}
+
+#else
+
+bool Instrumentation::Enabled() {
+    return false;
+}
+
+Instrumentation::Stats Instrumentation::ThreadStats() {
+    return Stats();
+}
+
+Instrumentation::Stats Instrumentation::Aggregate() {
+    return Stats();
+}
+
+void Instrumentation::Reset() {
+}
+
+#endif
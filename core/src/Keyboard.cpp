@@ -1,20 +1,36 @@
 #include "Keyboard.h"
+#include "Hashing.h"
+#include "PackedState.h"
 
 #include <boost/random/uniform_int_distribution.hpp>
 
 #include <algorithm>
+#include <vector>
 using namespace std;
 
+namespace {
+    const char state_magic[8] = "DODOKBD";
+    const uint32_t state_version = 1;
+
+    //the contribution of character c sitting on a key with the given polygon hash
+    inline uint64_t KeyTerm(const unsigned char c, const uint64_t polygon_hash) {
+        return HashMix(polygon_hash ^ HashMix(c));
+    }
+}
+
 Keyboard::Keyboard() {
     idx = 0;
+    hash = 0;
     for(unsigned int c = 0; c < 128; c++) {
         polygons[c] = Polygon();
+        key_hashes[c] = 0;
     }
 }
 
 Keyboard::Keyboard(const Keyboard& k) {
     for(unsigned int c = 0; c < 128; c++) {
         polygons[c] = Polygon(k.GetKey(c));
+        key_hashes[c] = k.key_hashes[c];
     }
 
     idx = k.idx;
@@ -23,6 +39,7 @@ Keyboard::Keyboard(const Keyboard& k) {
     }
 
     generator = k.generator;
+    hash = k.hash;
 }
 
 void Keyboard::AddKey(const unsigned char c, const Polygon& p) {
@@ -32,6 +49,9 @@ void Keyboard::AddKey(const unsigned char c, const Polygon& p) {
     polygons[c] = Polygon(p);
     entries[idx] = c;
     idx++;
+
+    key_hashes[c] = polygons[c].Hash();
+    hash ^= KeyTerm(c, key_hashes[c]);
 }
 
 void Keyboard::RemoveKey(const unsigned char c) {
@@ -46,11 +66,12 @@ void Keyboard::RemoveKey(const unsigned char c) {
     }
     //if we found it to remove
     if(subtract) {
+        hash ^= KeyTerm(c, key_hashes[c]);
+        key_hashes[c] = 0;
         polygons[c] = Polygon();
         idx--;
     }
 }
-
 Polygon Keyboard::GetKey(const unsigned char c) const {
     return polygons[c];
 }
@@ -72,8 +93,20 @@ void Keyboard::Reset() {
     for(unsigned int c = 0; c < 128; c++) {
         polygons[c] = Polygon();
         entries[c] = 0;
+        key_hashes[c] = 0;
     }
     idx = 0;
+    hash = 0;
+}
+
+//swaps the characters at two positions, their polygons stay where they are
+void Keyboard::SwapIndices(const unsigned int i1, const unsigned int i2) {
+    const unsigned char c1 = entries[i1], c2 = entries[i2];
+    hash ^= KeyTerm(c1, key_hashes[c1]) ^ KeyTerm(c2, key_hashes[c2]);
+    hash ^= KeyTerm(c1, key_hashes[c2]) ^ KeyTerm(c2, key_hashes[c1]);
+    swap(key_hashes[c1], key_hashes[c2]);
+    swap(entries[i1], entries[i2]);
+    swap(polygons[c1], polygons[c2]);
 }
 
 void Keyboard::SwapCharacters(const unsigned char c1, const unsigned char c2) {
@@ -89,10 +122,7 @@ void Keyboard::SwapCharacters(const unsigned char c1, const unsigned char c2) {
             found++; if(found==2) break;
         }
     }
-    //swap their indexes
-    swap(entries[i1], entries[i2]);
-    //swap the actual polygons
-    swap(polygons[c1], polygons[c2]);
+    SwapIndices(i1, i2);
 }
 
 //Fisher-yates shuffle
@@ -100,8 +130,7 @@ void Keyboard::Randomize() {
     for(unsigned int i = 0; i < idx; i++) {
         boost::random::uniform_int_distribution<> dist(i, idx-1);
         const unsigned int swapidx = dist(generator);
-        swap(entries[i], entries[swapidx]);
-        swap(polygons[entries[i]], polygons[entries[swapidx]]);
+        SwapIndices(i, swapidx);
     }
 }
 
@@ -110,16 +139,16 @@ void Keyboard::RandomSwap(unsigned int N) {
     for(unsigned int i = 0; i < N; i++) {
         const unsigned int i1 = dist(generator);
         const unsigned int i2 = dist(generator);
-        swap(entries[i1], entries[i2]);
-        swap(polygons[entries[i1]], polygons[entries[i2]]);
+        SwapIndices(i1, i2);
     }
 }
 
-bool Keyboard::operator==(const Keyboard& other) {
-    if(idx != other.idx)
+bool Keyboard::operator==(const Keyboard& other) const {
+    if(idx != other.idx || hash != other.hash)
         return false;    
-    for(unsigned int c = 0; c < idx; c++) {
-        if(!(GetKey(entries[c]) == other.GetKey(other.entries[c])))
+    for(unsigned int i = 0; i < idx; i++) {
+        const unsigned char c = entries[i];
+        if(key_hashes[c] != other.key_hashes[c] || !(polygons[c] == other.polygons[c]))
             return false;
     }
     return true;
@@ -129,3 +158,56 @@ void Keyboard::RandomNoop() {
     boost::random::uniform_int_distribution<> dist(0, 1);
     dist(generator);
 }
+
+void Keyboard::Rehash() {
+    hash = 0;
+    for(unsigned int c = 0; c < 128; c++) {
+        key_hashes[c] = 0;
+    }
+    for(unsigned int i = 0; i < idx; i++) {
+        key_hashes[entries[i]] = polygons[entries[i]].Hash();
+        hash ^= KeyTerm(entries[i], key_hashes[entries[i]]);
+    }
+}
+
+string Keyboard::PackState() const {
+    StateWriter state(state_magic, state_version);
+    state.PutU32(idx);
+    for(unsigned int i = 0; i < idx; i++) {
+        state.PutU8(entries[i]);
+        state.PutString(polygons[entries[i]].PackState());
+    }
+    return state.State();
+}
+
+bool Keyboard::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    uint32_t keys = 0;
+    if(!state.GetU32(keys) || keys > 128) {
+        return false;
+    }
+    vector<Polygon> read(128);
+    vector<unsigned char> order(keys);
+    vector<bool> seen(128, false);
+    for(unsigned int i = 0; i < keys; i++) {
+        uint8_t c = 0;
+        const char *bytes = 0;
+        size_t n = 0;
+        if(!state.GetU8(c) || c >= 128 || seen[c] || !state.GetBytes(bytes, n) || !read[c].UnpackState(bytes, n)) {
+            return false;
+        }
+        seen[c] = true;
+        order[i] = c;
+    }
+    if(!state.Finished()) {
+        return false;
+    }
+
+    for(unsigned int c = 0; c < 128; c++) {
+        polygons[c] = read[c];
+        entries[c] = c < keys ? order[c] : 0;
+    }
+    idx = keys;
+    Rehash();
+    return true;
+}
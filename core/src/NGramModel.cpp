@@ -0,0 +1,334 @@
+#include "NGramModel.h"
+#include "Hashing.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string.h>
+#include <sys/stat.h>
+#include "math.h"
+
+using namespace std;
+
+namespace {
+    const char magic[8] = {'D', 'O', 'D', 'O', 'N', 'G', 'M', '\0'};
+    const uint32_t ngram_version = 1;
+    const double discount = 0.75;
+
+    //n-grams are tagged with their length and contexts with their length plus 0x100
+    uint64_t Key(uint64_t tag, const uint32_t* ids, unsigned int n) {
+        uint64_t h = HashMix(tag);
+        for(unsigned int i = 0; i < n; i++) {
+            h = HashCombine(h, ids[i]);
+        }
+        return h;
+    }
+
+    uint64_t NGramKey(const uint32_t* ids, unsigned int n) { return Key(n, ids, n); }
+    uint64_t ContextKey(const uint32_t* ids, unsigned int n) { return Key(0x100 + n, ids, n); }
+
+    //the fixed size part of a saved model, followed by the vocabulary and the tables, each 8 byte aligned
+    class FileHeader {
+      public:
+        char magic[8];
+        uint32_t version, order;
+        uint64_t total, vocabulary, vocabulary_bytes, ngrams, contexts;
+    };
+
+    uint64_t Align(uint64_t offset) {
+        return (offset + 7)/8*8;
+    }
+
+    void Pad(ofstream& out) {
+        while(uint64_t(out.tellp()) % 8 != 0) out.put('\0');
+    }
+};
+
+const uint32_t NGramModel::unknown;
+
+NGramModel::NGramModel(unsigned int o) {
+    order = min(max(o, 1u), 3u);
+    total = 0;
+    prepared = false;
+    ngrams = contexts = 0;
+    unigram_offset = ngram_key_offset = ngram_count_offset = 0;
+    context_key_offset = context_total_offset = context_type_offset = 0;
+}
+
+template<typename T> const T* NGramModel::Table(const vector<T>& owned, uint64_t offset) const {
+    if(mapped.is_open()) return (const T*) (mapped.data() + offset);
+    return owned.size() > 0 ? &owned[0] : 0;
+}
+
+uint32_t NGramModel::AddId(const string& word) {
+    boost::unordered_map<string, uint32_t>::iterator it = ids.find(word);
+    if(it != ids.end()) return it->second;
+    const uint32_t id = vocabulary.size();
+    ids.insert(make_pair(word, id));
+    vocabulary.push_back(word);
+    unigrams.push_back(0);
+    return id;
+}
+
+void NGramModel::AddIds(const vector<uint32_t>& stream) {
+    Unprepare();
+    for(unsigned int i = 0; i < stream.size(); i++) {
+        unigrams[stream[i]]++;
+        total++;
+        for(unsigned int n = 2; n <= order && n <= i + 1; n++) {
+            const uint32_t *history = &stream[i + 1 - n];
+            uint32_t& count = building_ngrams[NGramKey(history, n)];
+            pair<uint32_t, uint32_t>& context = building_contexts[ContextKey(history, n - 1)];
+            context.first++;
+            if(count++ == 0) context.second++;
+        }
+    }
+}
+
+void NGramModel::AddWords(const vector<string>& words) {
+    vector<uint32_t> stream(words.size());
+    for(unsigned int i = 0; i < words.size(); i++) {
+        stream[i] = AddId(words[i]);
+    }
+    AddIds(stream);
+}
+
+unsigned int NGramModel::IngestFiles(const vector<string>& paths, const IngestOptions& options) {
+    const TokenCleaner cleaner(options);
+    unsigned int added = 0;
+    for(unsigned int f = 0; f < paths.size(); f++) {
+        struct stat info;
+        if(stat(paths[f].c_str(), &info) != 0) {
+            cerr << "ERROR: Unable to read " << paths[f] << "." << endl;
+            continue;
+        }
+        if(info.st_size == 0) continue;
+        boost::iostreams::mapped_file_source file;
+        try {
+            file.open(paths[f]);
+        }
+        catch(exception& e) {
+            cerr << "ERROR: Unable to map " << paths[f] << ": " << e.what() << endl;
+            continue;
+        }
+        vector<uint32_t> stream;
+        string token;
+        const char *p = file.data(), *end = file.data() + file.size();
+        while(cleaner.Next(p, end, token)) {
+            stream.push_back(AddId(token));
+        }
+        AddIds(stream);
+        added += stream.size();
+    }
+    return added;
+}
+
+void NGramModel::Prepare() {
+    if(prepared) return;
+
+    vector< pair<uint64_t, uint32_t> > sorted_ngrams(building_ngrams.begin(), building_ngrams.end());
+    sort(sorted_ngrams.begin(), sorted_ngrams.end());
+    ngrams = sorted_ngrams.size();
+    ngram_keys.resize(ngrams);
+    ngram_counts.resize(ngrams);
+    for(unsigned int i = 0; i < ngrams; i++) {
+        ngram_keys[i] = sorted_ngrams[i].first;
+        ngram_counts[i] = sorted_ngrams[i].second;
+    }
+
+    vector< pair<uint64_t, pair<uint32_t, uint32_t> > > sorted_contexts(building_contexts.begin(), building_contexts.end());
+    sort(sorted_contexts.begin(), sorted_contexts.end());
+    contexts = sorted_contexts.size();
+    context_keys.resize(contexts);
+    context_totals.resize(contexts);
+    context_types.resize(contexts);
+    for(unsigned int i = 0; i < contexts; i++) {
+        context_keys[i] = sorted_contexts[i].first;
+        context_totals[i] = sorted_contexts[i].second.first;
+        context_types[i] = sorted_contexts[i].second.second;
+    }
+
+    building_ngrams.clear();
+    building_contexts.clear();
+    prepared = true;
+}
+
+void NGramModel::Unprepare() {
+    if(!prepared) return;
+    const uint64_t *nk = Table(ngram_keys, ngram_key_offset), *ck = Table(context_keys, context_key_offset);
+    const uint32_t *nc = Table(ngram_counts, ngram_count_offset);
+    const uint32_t *ct = Table(context_totals, context_total_offset), *cy = Table(context_types, context_type_offset);
+    for(uint64_t i = 0; i < ngrams; i++) {
+        building_ngrams[nk[i]] = nc[i];
+    }
+    for(uint64_t i = 0; i < contexts; i++) {
+        building_contexts[ck[i]] = make_pair(ct[i], cy[i]);
+    }
+    if(mapped.is_open()) {
+        const uint32_t *u = Table(unigrams, unigram_offset);
+        unigrams.assign(u, u + vocabulary.size());
+        mapped.close();
+    }
+    ngram_keys.clear();
+    ngram_counts.clear();
+    context_keys.clear();
+    context_totals.clear();
+    context_types.clear();
+    ngrams = contexts = 0;
+    prepared = false;
+}
+
+uint64_t NGramModel::NGrams() {
+    Prepare();
+    return ngrams;
+}
+
+uint32_t NGramModel::WordId(const char* word) const {
+    boost::unordered_map<string, uint32_t>::const_iterator it = ids.find(word);
+    return it != ids.end() ? it->second : unknown;
+}
+
+uint32_t NGramModel::NGramCount(uint64_t key) const {
+    const uint64_t *keys = Table(ngram_keys, ngram_key_offset);
+    const uint64_t *found = lower_bound(keys, keys + ngrams, key);
+    if(found == keys + ngrams || *found != key) return 0;
+    return Table(ngram_counts, ngram_count_offset)[found - keys];
+}
+
+bool NGramModel::ContextCounts(uint64_t key, uint32_t& context_total, uint32_t& context_types_out) const {
+    const uint64_t *keys = Table(context_keys, context_key_offset);
+    const uint64_t *found = lower_bound(keys, keys + contexts, key);
+    if(found == keys + contexts || *found != key) return false;
+    context_total = Table(context_totals, context_total_offset)[found - keys];
+    context_types_out = Table(context_types, context_type_offset)[found - keys];
+    return true;
+}
+
+double NGramModel::UnigramProbability(uint32_t w) const {
+    const double count = w != unknown ? Table(unigrams, unigram_offset)[w] : 0;
+    return (count + 1.0)/(double(total) + double(vocabulary.size()) + 1.0);
+}
+
+double NGramModel::LogProbability(uint32_t u, uint32_t v, uint32_t w) {
+    Prepare();
+    double p = UnigramProbability(w);
+    const uint32_t history[3] = {u, v, w};
+    uint32_t context_total, types;
+    //each order present interpolates the discounted counts with the order below
+    for(unsigned int n = 2; n <= order; n++) {
+        const uint32_t *ngram = history + 3 - n;
+        bool known = true;
+        for(unsigned int i = 0; i < n - 1; i++) known = known && ngram[i] != unknown;
+        if(!known || !ContextCounts(ContextKey(ngram, n - 1), context_total, types)) break;
+        const double count = w != unknown ? NGramCount(NGramKey(ngram, n)) : 0;
+        p = (max(count - discount, 0.0) + discount*double(types)*p)/double(context_total);
+    }
+    return log(p);
+}
+
+double NGramModel::Probability(const vector<string>& context, const char* word) {
+    uint32_t u = unknown, v = unknown;
+    if(context.size() >= 1) v = WordId(context[context.size()-1].c_str());
+    if(context.size() >= 2) u = WordId(context[context.size()-2].c_str());
+    return exp(LogProbability(u, v, WordId(word)));
+}
+
+bool NGramModel::Save(const string& filename) {
+    Prepare();
+    ofstream out(filename.c_str(), ios::binary | ios::trunc);
+    if(!out.is_open()) {
+        cerr << "ERROR: Unable to create the n-gram model " << filename << "." << endl;
+        return false;
+    }
+
+    string words;
+    for(unsigned int i = 0; i < vocabulary.size(); i++) {
+        words += vocabulary[i];
+        words += '\0';
+    }
+    FileHeader header;
+    memcpy(header.magic, magic, sizeof(magic));
+    header.version = ngram_version;
+    header.order = order;
+    header.total = total;
+    header.vocabulary = vocabulary.size();
+    header.vocabulary_bytes = words.size();
+    header.ngrams = ngrams;
+    header.contexts = contexts;
+
+    out.write((const char*) &header, sizeof(header));
+    out.write(words.data(), words.size());
+    Pad(out);
+    out.write((const char*) Table(unigrams, unigram_offset), vocabulary.size()*sizeof(uint32_t));
+    Pad(out);
+    out.write((const char*) Table(ngram_keys, ngram_key_offset), ngrams*sizeof(uint64_t));
+    out.write((const char*) Table(ngram_counts, ngram_count_offset), ngrams*sizeof(uint32_t));
+    Pad(out);
+    out.write((const char*) Table(context_keys, context_key_offset), contexts*sizeof(uint64_t));
+    out.write((const char*) Table(context_totals, context_total_offset), contexts*sizeof(uint32_t));
+    out.write((const char*) Table(context_types, context_type_offset), contexts*sizeof(uint32_t));
+    out.flush();
+    return out.good();
+}
+
+bool NGramModel::Load(const string& filename) {
+    boost::iostreams::mapped_file_source file;
+    try {
+        file.open(filename);
+    }
+    catch(exception& e) {
+        cerr << "ERROR: Unable to map " << filename << ": " << e.what() << endl;
+        return false;
+    }
+
+    FileHeader header;
+    if(file.size() < sizeof(header)) {
+        cerr << "ERROR: " << filename << " is not an n-gram model." << endl;
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    if(memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != ngram_version || header.order < 1 || header.order > 3) {
+        cerr << "ERROR: " << filename << " is not an n-gram model this version can read." << endl;
+        return false;
+    }
+
+    //the same layout Save writes
+    const uint64_t words_offset = sizeof(header);
+    const uint64_t unigrams_at = Align(words_offset + header.vocabulary_bytes);
+    const uint64_t ngrams_at = Align(unigrams_at + header.vocabulary*sizeof(uint32_t));
+    const uint64_t contexts_at = Align(ngrams_at + header.ngrams*(sizeof(uint64_t) + sizeof(uint32_t)));
+    const uint64_t end = contexts_at + header.contexts*(sizeof(uint64_t) + 2*sizeof(uint32_t));
+    if(end > file.size()) {
+        cerr << "ERROR: The n-gram model " << filename << " is incomplete." << endl;
+        return false;
+    }
+
+    NGramModel m(header.order);
+    const char *words = file.data() + words_offset;
+    for(uint64_t start = 0; start < header.vocabulary_bytes; ) {
+        const char *nul = (const char*) memchr(words + start, '\0', header.vocabulary_bytes - start);
+        if(nul == 0) break;
+        const string word(words + start, nul - (words + start));
+        m.ids.insert(make_pair(word, (uint32_t) m.vocabulary.size()));
+        m.vocabulary.push_back(word);
+        start = nul - words + 1;
+    }
+    if(m.vocabulary.size() != header.vocabulary) {
+        cerr << "ERROR: The n-gram model " << filename << " has a corrupted vocabulary." << endl;
+        return false;
+    }
+
+    m.total = header.total;
+    m.ngrams = header.ngrams;
+    m.contexts = header.contexts;
+    m.unigram_offset = unigrams_at;
+    m.ngram_key_offset = ngrams_at;
+    m.ngram_count_offset = ngrams_at + header.ngrams*sizeof(uint64_t);
+    m.context_key_offset = contexts_at;
+    m.context_total_offset = contexts_at + header.contexts*sizeof(uint64_t);
+    m.context_type_offset = m.context_total_offset + header.contexts*sizeof(uint32_t);
+    m.mapped = file;
+    m.prepared = true;
+    *this = m;
+    return true;
+}
@@ -0,0 +1,118 @@
+#include "PerfectVectorIndex.h"
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <utility>
+#include "math.h"
+
+using namespace std;
+
+namespace {
+    //ranges this small are scanned rather than split further
+    const unsigned int leaf_size = 8;
+};
+
+PerfectVectorIndex::PerfectVectorIndex() {
+    vectors = points = 0;
+}
+
+bool PerfectVectorIndex::Build(InputVector* v, unsigned int n) {
+    coordinates.clear();
+    order.clear();
+    radius.clear();
+    vectors = points = 0;
+    for(unsigned int i = 1; i < n; i++) {
+        if(v[i].Length() != v[0].Length()) return false;
+    }
+    if(n == 0) return true;
+
+    vectors = n;
+    points = v[0].Length();
+    coordinates.resize(2*points*n);
+    for(unsigned int c = 0; c < n; c++) {
+        double *row = coordinates.data() + 2*points*c;
+        for(unsigned int i = 0; i < points; i++) {
+            row[2*i] = v[c].X(i);
+            row[2*i + 1] = v[c].Y(i);
+        }
+    }
+    order.resize(n);
+    for(unsigned int c = 0; c < n; c++) order[c] = c;
+    radius.assign(n, 0);
+    BuildNode(0, n);
+    return true;
+}
+
+double PerfectVectorIndex::Distance(const double* a, const double* b) const {
+    double d2 = 0;
+    for(unsigned int i = 0; i < points; i++) {
+        d2 += pow(a[2*i] - b[2*i], 2) + pow(a[2*i + 1] - b[2*i + 1], 2);
+    }
+    return sqrt(d2);
+}
+
+void PerfectVectorIndex::BuildNode(unsigned int begin, unsigned int end) {
+    if(end - begin <= leaf_size) return;
+    //the first vector of the range is the vantage point, and the rest are split at the median distance from it
+    const double *vantage = coordinates.data() + 2*points*order[begin];
+    vector<pair<double, unsigned int> > others;
+    others.reserve(end - begin - 1);
+    for(unsigned int c = begin + 1; c < end; c++) {
+        others.push_back(make_pair(Distance(vantage, coordinates.data() + 2*points*order[c]), order[c]));
+    }
+    const unsigned int half = others.size()/2;
+    nth_element(others.begin(), others.begin() + half, others.end());
+    radius[begin] = others[half].first;
+    for(unsigned int c = 0; c < others.size(); c++) {
+        order[begin + 1 + c] = others[c].second;
+    }
+    BuildNode(begin + 1, begin + 1 + half);
+    BuildNode(begin + 1 + half, end);
+}
+
+void PerfectVectorIndex::Within(const double* query, double r, unsigned int begin, unsigned int end,
+        vector<unsigned int>& neighbours, vector<double>& distances) const {
+    if(begin >= end) return;
+    if(end - begin <= leaf_size) {
+        DODONA_COUNT(VectorDistance, end - begin);
+        for(unsigned int c = begin; c < end; c++) {
+            const double d = Distance(query, coordinates.data() + 2*points*order[c]);
+            if(d < r) {
+                neighbours.push_back(order[c]);
+                distances.push_back(d);
+            }
+        }
+        return;
+    }
+
+    DODONA_COUNT(VectorDistance, 1);
+    const double d = Distance(query, coordinates.data() + 2*points*order[begin]);
+    if(d < r) {
+        neighbours.push_back(order[begin]);
+        distances.push_back(d);
+    }
+    //everything in the inner half is within radius of the vantage point and everything in the outer
+    //half at least that far, so a half the query's ball can't reach is skipped
+    const unsigned int middle = begin + 1 + (end - begin - 1)/2;
+    if(d - r < radius[begin]) Within(query, r, begin + 1, middle, neighbours, distances);
+    if(d + r >= radius[begin]) Within(query, r, middle, end, neighbours, distances);
+}
+
+void PerfectVectorIndex::Within(InputVector& query, double r, vector<unsigned int>& neighbours, vector<double>& distances) const {
+    neighbours.clear();
+    distances.clear();
+    if(vectors == 0 || query.Length() != points) return;
+    vector<double> q(2*points);
+    for(unsigned int i = 0; i < points; i++) {
+        q[2*i] = query.X(i);
+        q[2*i + 1] = query.Y(i);
+    }
+    Within(q.data(), r, 0, vectors, neighbours, distances);
+}
+
+void PerfectVectorIndex::Within(unsigned int i, double r, vector<unsigned int>& neighbours, vector<double>& distances) const {
+    neighbours.clear();
+    distances.clear();
+    if(i >= vectors) return;
+    Within(coordinates.data() + 2*points*i, r, 0, vectors, neighbours, distances);
+}
@@ -0,0 +1,185 @@
+#include "PerfectVectorStore.h"
+#include "SampleSet.h"
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <iostream>
+#include "math.h"
+
+using namespace std;
+
+namespace {
+    //the largest quantized magnitude, leaving headroom so clamped queries can't wrap
+    const double int16_range = 32000;
+
+    //acc[c] += (data[r][c] - query[r])^2 over every stored coordinate row r
+    template<typename T, typename A>
+    void Accumulate(const T* data, unsigned int n, unsigned int rows, const A* query, A* acc) {
+        for(unsigned int r = 0; r < rows; r++) {
+            const T *row = data + r*n;
+            const A q = query[r];
+            for(unsigned int c = 0; c < n; c++) {
+                const A e = A(row[c]) - q;
+                acc[c] += e*e;
+            }
+        }
+    }
+
+    template<typename A>
+    void Finish(const A* acc, unsigned int n, double cap2, double scale, double* distances) {
+        for(unsigned int c = 0; c < n; c++) {
+            double d2 = double(acc[c]);
+            if(cap2 > 0 && d2 > cap2) d2 = cap2;
+            distances[c] = sqrt(d2)*scale;
+        }
+    }
+};
+
+PerfectVectorStore::PerfectVectorStore(Precision p) {
+    precision = p;
+    vectors = points = 0;
+    offset = 0;
+    scale = 1;
+}
+
+bool PerfectVectorStore::Build(InputVector* v, unsigned int n) {
+    doubles.clear();
+    floats.clear();
+    shorts.clear();
+    vectors = points = 0;
+    offset = 0;
+    scale = 1;
+    for(unsigned int i = 1; i < n; i++) {
+        if(v[i].Length() != v[0].Length()) return false;
+    }
+    if(n == 0) return true;
+
+    vectors = n;
+    points = v[0].Length();
+    const unsigned int rows = 2*points;
+    //x coordinates fill rows [0, points) and y coordinates rows [points, 2*points)
+    vector<double> values(rows*n);
+    for(unsigned int c = 0; c < n; c++) {
+        for(unsigned int i = 0; i < points; i++) {
+            values[i*n + c] = v[c].X(i);
+            values[(points + i)*n + c] = v[c].Y(i);
+        }
+    }
+
+    switch(precision) {
+        case Double:
+            doubles.swap(values);
+            break;
+        case Float:
+            floats.assign(values.begin(), values.end());
+            break;
+        case Int16: {
+            double low = values.size() > 0 ? *min_element(values.begin(), values.end()) : 0;
+            double high = values.size() > 0 ? *max_element(values.begin(), values.end()) : 0;
+            //noisy queries land outside the perfect vectors so leave a margin of half the span on each side
+            offset = 0.5*(low + high);
+            scale = high > low ? (high - low)/int16_range : 1;
+            shorts.resize(values.size());
+            for(unsigned int j = 0; j < values.size(); j++) {
+                shorts[j] = int16_t(floor((values[j] - offset)/scale + 0.5));
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool PerfectVectorStore::Build(InputModel& model, Keyboard& keyboard, WordList& words) {
+    vector<InputVector> perfect(words.Words());
+    for(unsigned int i = 0; i < words.Words(); i++) {
+        perfect[i] = model.PerfectVector(words.Word(i), keyboard);
+    }
+    return Build(perfect.size() > 0 ? &perfect[0] : 0, perfect.size());
+}
+
+unsigned int PerfectVectorStore::Bytes() const {
+    return doubles.size()*sizeof(double) + floats.size()*sizeof(float) + shorts.size()*sizeof(int16_t);
+}
+
+void PerfectVectorStore::Distances(InputVector& query, double* distances, double maxdistance) const {
+    if(vectors == 0) return;
+    DODONA_COUNT(VectorDistance, vectors);
+    const unsigned int rows = 2*points;
+    const double cap2 = maxdistance > 0 ? maxdistance*maxdistance : 0;
+    switch(precision) {
+        case Double: {
+            vector<double> q(rows), acc(vectors, 0.0);
+            for(unsigned int i = 0; i < points; i++) {
+                q[i] = query.X(i);
+                q[points + i] = query.Y(i);
+            }
+            Accumulate(&doubles[0], vectors, rows, &q[0], &acc[0]);
+            Finish(&acc[0], vectors, cap2, 1.0, distances);
+            break;
+        }
+        case Float: {
+            vector<float> q(rows), acc(vectors, 0.0f);
+            for(unsigned int i = 0; i < points; i++) {
+                q[i] = query.X(i);
+                q[points + i] = query.Y(i);
+            }
+            Accumulate(&floats[0], vectors, rows, &q[0], &acc[0]);
+            Finish(&acc[0], vectors, cap2, 1.0, distances);
+            break;
+        }
+        case Int16: {
+            //differences of quantized values are exact in float so only the squares round
+            vector<float> q(rows), acc(vectors, 0.0f);
+            for(unsigned int i = 0; i < rows; i++) {
+                const double value = i < points ? query.X(i) : query.Y(i - points);
+                const double quantized = floor((value - offset)/scale + 0.5);
+                q[i] = max(-32767.0, min(32767.0, quantized));
+            }
+            Accumulate(&shorts[0], vectors, rows, &q[0], &acc[0]);
+            Finish(&acc[0], vectors, cap2/(scale*scale), scale, distances);
+            break;
+        }
+    }
+}
+
+unsigned int PerfectVectorStore::Nearest(InputVector& query) const {
+    vector<double> distances(vectors);
+    Distances(query, distances.size() > 0 ? &distances[0] : 0);
+    return min_element(distances.begin(), distances.end()) - distances.begin();
+}
+
+PrecisionReport PerfectVectorStore::Validate(InputModel& model, Keyboard& keyboard, WordList& words, Precision p,
+        unsigned int samples, unsigned int seed) {
+    PrecisionReport report;
+    PerfectVectorStore exact(Double), reduced(p);
+    if(!exact.Build(model, keyboard, words) || !reduced.Build(model, keyboard, words)) {
+        cerr << "ERROR: The perfect vectors don't all have the same length so they can't be stored together." << endl;
+        return report;
+    }
+    if(exact.Vectors() == 0) return report;
+
+    SampleSet sample_set(words, samples, seed);
+    vector<double> d1(exact.Vectors()), d2(exact.Vectors());
+    double total_error = 0;
+    for(unsigned int s = 0; s < sample_set.Samples(); s++) {
+        const char *word = words.Word(sample_set.WordIndex(s));
+        InputVector query = model.OffsetVector(word, keyboard, sample_set.Offsets(s));
+        if(query.Length() != exact.Points()) continue;
+
+        exact.Distances(query, &d1[0]);
+        reduced.Distances(query, &d2[0]);
+        const unsigned int best1 = min_element(d1.begin(), d1.end()) - d1.begin();
+        const unsigned int best2 = min_element(d2.begin(), d2.end()) - d2.begin();
+        if(best1 != best2) report.changed++;
+        for(unsigned int i = 0; i < d1.size(); i++) {
+            const double error = fabs(d1[i] - d2[i]);
+            report.max_error = max(report.max_error, error);
+            total_error += error;
+        }
+        report.samples++;
+    }
+    if(report.samples > 0) {
+        report.mean_error = total_error/(double(report.samples)*double(d1.size()));
+    }
+    return report;
+}
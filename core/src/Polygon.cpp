@@ -1,7 +1,14 @@
 #include "Polygon.h"
+#include "Hashing.h"
+#include "PackedState.h"
 
 using namespace std;
 
+namespace {
+    const char state_magic[8] = "DODOPLY";
+    const uint32_t state_version = 1;
+}
+
 Polygon::Polygon() {
 
 }
@@ -107,7 +114,7 @@ bool Polygon::IsInside(double x, double y) {
     return false;
 }
 
-bool Polygon::operator==(const Polygon& other) {
+bool Polygon::operator==(const Polygon& other) const {
     if(vertices.size() != other.VertexCount())
         return false;
 
@@ -119,3 +126,39 @@ bool Polygon::operator==(const Polygon& other) {
     return true;
 }
 
+uint64_t Polygon::Hash() const {
+    uint64_t h = vertices.size();
+    for(unsigned int i = 0; i < vertices.size(); i++) {
+        h = HashCombine(h, HashDouble(vertices[i].first));
+        h = HashCombine(h, HashDouble(vertices[i].second));
+    }
+    return h;
+}
+
+string Polygon::PackState() const {
+    StateWriter state(state_magic, state_version);
+    state.PutU32(vertices.size());
+    for(unsigned int i = 0; i < vertices.size(); i++) {
+        state.PutDouble(vertices[i].first);
+        state.PutDouble(vertices[i].second);
+    }
+    return state.State();
+}
+
+bool Polygon::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    uint32_t n = 0;
+    if(!state.GetU32(n) || !state.Fits(n, 16)) {
+        return false;
+    }
+    vector< pair<double, double> > read(n);
+    for(unsigned int i = 0; i < n; i++) {
+        state.GetDouble(read[i].first);
+        state.GetDouble(read[i].second);
+    }
+    if(!state.Finished()) {
+        return false;
+    }
+    vertices.swap(read);
+    return true;
+}
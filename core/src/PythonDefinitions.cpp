@@ -1,12 +1,17 @@
 //boost include files
 #include <boost/python/module.hpp>
 #include <boost/python/def.hpp>
+#include <boost/python/enum.hpp>
+#include <boost/python/scope.hpp>
 
 //core include files
 #include "FitnessFunctions.h"
 #include "FitnessResult.h"
 #include "Serialization.h"
 #include "DataFormat.h"
+#include "SampleSet.h"
+#include "PerfectVectorStore_py.h"
+#include "FitnessCache.h"
 
 #include "InputModels/SimpleGaussianModel.h"
 #include "InputModels/SimpleInterpolationModel.h"
@@ -27,9 +32,14 @@
 #include "InputModels/InputModel_py.h"
 #include "InputModels/SimpleInterpolationModel_py.h"
 #include "DataFormat_py.h"
-#ifndef NO_FANN
+#include "ResultsLog_py.h"
+#include "ResultsTable_py.h"
+#include "ConfusionMatrix_py.h"
+#include "NGramModel_py.h"
+#include "FitnessFunctions_py.h"
+#include "Instrumentation_py.h"
+#include "Tracing_py.h"
 #include "InputModels/NeuralNetworkModel_py.h"
-#endif
 
 
 using namespace boost::python;
@@ -46,6 +56,7 @@ template<typename T> struct serialization_pickle_suite : pickle_suite {
         return str(os.str());
     };
     static void setstate(T& t, object entries) {
+        CheckNoArrayViews(&t);
         str s = extract<str>(entries)();
         std::string st = extract<std::string>(s)();
         std::istringstream is(st);
@@ -56,6 +67,28 @@ template<typename T> struct serialization_pickle_suite : pickle_suite {
 };
 
 
+//the core classes pickle to bytes in PackedState.h's fixed little-endian layout, which is smaller and
+//faster than the text archive and reads back the same on any platform.  str states from the text
+//archives still load.
+template<typename T> struct packed_pickle_suite : serialization_pickle_suite<T> {
+    static object getstate(T& t) {
+        const std::string st = t.PackState();
+        return object(handle<>(PyBytes_FromStringAndSize(st.data(), st.size())));
+    };
+    static void setstate(T& t, object entries) {
+        if(!PyBytes_Check(entries.ptr())) {
+            serialization_pickle_suite<T>::setstate(t, entries);
+            return;
+        }
+        CheckNoArrayViews(&t);
+        if(!t.UnpackState(PyBytes_AS_STRING(entries.ptr()), PyBytes_GET_SIZE(entries.ptr()))) {
+            PyErr_SetString(PyExc_ValueError, "Not a state this version of dodona can read.");
+            throw_error_already_set();
+        }
+    };
+};
+
+
 /********************************************************/
 /***************** Python Module ************************/
 /********************************************************/
@@ -67,25 +100,56 @@ BOOST_PYTHON_MODULE(core)
     
     class_<WordList>("WordList")
         .def("AddWord", &WordList::AddWord, AddWord_overloads())
+        .def("IngestFiles", &WordListIngestFiles)
+        .def("IngestFiles", &WordListIngestFiles1)
         .def("Occurances", Occurances1)
         .def("Occurances", Occurances2)
         .def("TotalOccurances", &WordList::TotalOccurances)
         .def("Word", &WordList::Word)
         .def("Words", &WordList::Words)
-        .def("RandomWord", &WordList::RandomWord)
+        .def("RandomWord", RandomWord1)
         .def("WordIndex", &WordList::WordIndex)
         .def("LetterOccurances", &WordList::LetterOccurances)
         .def("TotalLetterOccurances", &WordList::TotalLetterOccurances)
         .def("SetSeed", &WordList::SetSeed)
+        .def("Fingerprint", &WordList::Fingerprint)
         .def("Reset", &WordList::Reset)
         .def(self + self)
         .def("WordListDict",&WordListMapDict)
         .def("SetWordListDict",&SetWordListMapDict)
         .def("__deepcopy__", &DeepCopy<WordList>)
-        .def_pickle(serialization_pickle_suite<WordList>())
+        .def_pickle(packed_pickle_suite<WordList>())
         .def("SaveToFile", &SaveToFile<WordList>)
         .def("LoadFromFile", &LoadFromFile<WordList>)
         .def("SubstringMatches", &WordListTreeMatches)
+        .def("TopN", &WordList::TopN)
+    ;
+
+    def("MergeWordLists", &MergeWordLists);
+    def("MergeWordLists", &MergeWordLists1);
+    def("ZipfianWordList", &WordList::Zipfian, Zipfian_overloads());
+
+    class_<FrozenWordList, boost::noncopyable>("FrozenWordList", init<WordList&>())
+        .def("Occurances", FrozenOccurances1)
+        .def("Occurances", FrozenOccurances2)
+        .def("TotalOccurances", &FrozenWordList::TotalOccurances)
+        .def("Word", &FrozenWordList::Word)
+        .def("Words", &FrozenWordList::Words)
+        .def("WordIndex", &FrozenWordList::WordIndex)
+        .def("LetterOccurances", &FrozenWordList::LetterOccurances)
+        .def("TotalLetterOccurances", &FrozenWordList::TotalLetterOccurances)
+        .def("Fingerprint", &FrozenWordList::Fingerprint)
+        .def("SubstringMatches", &FrozenWordListTreeMatches)
+    ;
+/********************************************************/
+
+/***************** IngestOptions class ******************/
+    class_<IngestOptions>("IngestOptions")
+        .def_readwrite("alpha_only", &IngestOptions::alpha_only)
+        .def_readwrite("lowercase", &IngestOptions::lowercase)
+        .def_readwrite("keep", &IngestOptions::keep)
+        .def_readwrite("min_length", &IngestOptions::min_length)
+        .def_readwrite("threads", &IngestOptions::threads)
     ;
 /********************************************************/
 
@@ -104,7 +168,7 @@ BOOST_PYTHON_MODULE(core)
         .def("BottomExtreme", &Polygon::BottomExtreme)
         .def("IsInside", &Polygon::IsInside)
         .def("__deepcopy__", &DeepCopy<Polygon>)
-        .def_pickle(serialization_pickle_suite<Polygon>())
+        .def_pickle(packed_pickle_suite<Polygon>())
         .def("SaveToFile", &SaveToFile<Polygon>)
         .def("LoadFromFile", &LoadFromFile<Polygon>)
     ;
@@ -126,22 +190,32 @@ BOOST_PYTHON_MODULE(core)
         .def("RandomSwap", &Keyboard::RandomSwap)
         .def("RandomNoop", &Keyboard::RandomNoop)
         .def("SetSeed", &Keyboard::SetSeed)
+        .def("Hash", &Keyboard::Hash)
+        .def("__hash__", &Keyboard::Hash)
+        .def(self == self)
         .def("__deepcopy__", &DeepCopy<Keyboard>)
-        .def_pickle(serialization_pickle_suite<Keyboard>())
+        .def_pickle(packed_pickle_suite<Keyboard>())
         .def("SaveToFile", &SaveToFile<Keyboard>)
         .def("LoadFromFile", &LoadFromFile<Keyboard>)
     ;
+    //the layouts of keyboards.py, built natively
+    def("StandardKeyboard", &StandardKeyboards::Qwerty, Qwerty_overloads());
+    def("DvorakKeyboard", &StandardKeyboards::Dvorak, Dvorak_overloads());
+    def("HexagonalKeyboard", &StandardKeyboards::Hexagonal, Hexagonal_overloads());
+    def("T9Keyboard", &StandardKeyboards::T9, T9_overloads());
 /********************************************************/
 
 /***************** InputModel classes ***********************/
 
     class_<InputModelWrapper, boost::noncopyable>("InputModel")
-        .def("RandomVector", pure_virtual(&InputModel::RandomVector))
+        .def("RandomVector", RandomVector1)
         .def("PerfectVector", pure_virtual(&InputModel::PerfectVector))
         .def("Distance", pure_virtual(&InputModel::Distance))
         .def("VectorDistance", pure_virtual(&InputModel::VectorDistance))
         .def("SetSeed", &InputModel::SetSeed)
-        .def("BestMatch", &InputModel::BestMatch)
+        .def("Fingerprint", &InputModel::Fingerprint)
+        .def("BestMatch", BestMatch1)
+        .def("BestMatch", BestMatch2)
     ;
     
     class_<SimpleGaussianModel, bases<InputModel> >("SimpleGaussianModel")
@@ -173,30 +247,54 @@ BOOST_PYTHON_MODULE(core)
         //.def("SetSeed", &SimpleInterpolationModel::SetSeed)
     ;
 
-#ifndef NO_FANN
     class_<NeuralNetworkModel, bases<SimpleInterpolationModel, InputModel> >("NeuralNetworkModel", init<const char*>())
         .def("CreateInputs", &NeuralNetworkInputs)
+        .def("SetANN", &NeuralNetworkModel::SetANN)
     ;
-#endif
 /********************************************************/
 
 /***************** InputVector class ********************/
-    
+
+    RegisterArrayView();
+
     class_<InputVector>("InputVector")
         .def("Length", &InputVector::Length)
-        .def("AddPoint", &InputVector::AddPoint)
-        .def("RemovePoint", &InputVector::RemovePoint)
+        .def("AddPoint", &InputVectorAddPoint)
+        .def("RemovePoint", &InputVectorRemovePoint)
         .def("X", &InputVector::X)
         .def("Y", &InputVector::Y)
         .def("T", &InputVector::T)
         .def("SpatialLength", &InputVector::SpatialLength)
         .def("TemporalLength", &InputVector::TemporalLength)
         .def("PointList", &InputVectorList)
+        .def("XArray", &InputVectorXArray)
+        .def("YArray", &InputVectorYArray)
+        .def("TArray", &InputVectorTArray)
+        .def("SetPoints", &InputVectorSetPoints)
         .def("DeltaPhi", &InputVector::DeltaPhi)
         .def("StringForm", &InputVector::StringForm)
-        .def_pickle(serialization_pickle_suite<InputVector>())
+        .def_pickle(packed_pickle_suite<InputVector>())
         .def("SaveToFile", &SaveToFile<InputVector>)
-        .def("LoadFromFile", &LoadFromFile<InputVector>)
+        .def("LoadFromFile", &LoadFromFileWithoutViews<InputVector>)
+    ;
+/********************************************************/
+
+/***************** InputVectorBatch class ***************/
+
+    class_<InputVectorBatch>("InputVectorBatch", init<unsigned int>())
+        .def(init<>())
+        .def("Vectors", &InputVectorBatch::Vectors)
+        .def("Points", &InputVectorBatch::Points)
+        .def("Reserve", &InputVectorBatchReserve)
+        .def("Clear", &InputVectorBatchClear)
+        .def("Add", &InputVectorBatchAdd)
+        .def("Get", &InputVectorBatch::Get)
+        .def("AddRandom", &InputVectorBatchAddRandom)
+        .def("AddSamples", &InputVectorBatchAddSamples)
+        .def("Array", &InputVectorBatchArray)
+        .def_pickle(packed_pickle_suite<InputVectorBatch>())
+        .def("SaveToFile", &SaveToFile<InputVectorBatch>)
+        .def("LoadFromFile", &LoadFromFileWithoutViews<InputVectorBatch>)
     ;
 /********************************************************/
 
@@ -219,27 +317,192 @@ BOOST_PYTHON_MODULE(core)
         .def(self + self)
         .def("Fitness", &FitnessResult::Fitness)
         .def("Error", &FitnessResult::Error)
+        .def("Truncation", &FitnessResult::Truncation)
         .def("Iterations", &FitnessResult::Iterations)
-        .def_pickle(serialization_pickle_suite<FitnessResult>())
+        .def("Stats", &FitnessResultStats)
+        .def_pickle(packed_pickle_suite<FitnessResult>())
         .def("SaveToFile", &SaveToFile<FitnessResult>)
         .def("LoadFromFile", &LoadFromFile<FitnessResult>)
     ;
 /********************************************************/
 
+/***************** ConfusionMatrix class ****************/
+
+    class_<Confusion>("Confusion", init<>())
+        .def_readonly("target", &Confusion::target)
+        .def_readonly("decoded", &Confusion::decoded)
+        .def_readonly("count", &Confusion::count)
+        .def_readonly("samples", &Confusion::samples)
+        .def_readonly("rate", &Confusion::rate)
+        .def_readonly("rate_error", &Confusion::rate_error)
+        .def_readonly("share", &Confusion::share)
+        .def_readonly("share_error", &Confusion::share_error)
+    ;
+
+    class_<ConfusionMatrix>("ConfusionMatrix", init<>())
+        .def("Words", &ConfusionMatrix::Words)
+        .def("Targets", &ConfusionMatrix::Targets)
+        .def("Entries", &ConfusionMatrix::Entries)
+        .def("Samples", &ConfusionMatrix::Samples)
+        .def("Weight", &ConfusionMatrix::Weight)
+        .def("Count", &ConfusionMatrix::Count)
+        .def("Entry", &ConfusionMatrix::Entry)
+        .def("TopConfusions", &ConfusionMatrixTopConfusions)
+        .def("Efficiency", &ConfusionMatrix::Efficiency)
+        .def("Arrays", &ConfusionMatrixArrays)
+    ;
+/********************************************************/
+
+/***************** ImportanceProposal class *************/
+
+    class_<ImportanceProposal>("ImportanceProposal", init<Keyboard&, InputModel&, WordList&, double>())
+        .def(init<>())
+        .def("Build", &ImportanceProposal::Build)
+        .def("Words", &ImportanceProposal::Words)
+        .def("Confusion", &ImportanceProposal::Confusion)
+        .def("MeanConfusion", &ImportanceProposal::MeanConfusion)
+    ;
+/********************************************************/
+
+/***************** SampleSet class **********************/
+
+    class_<SampleSet>("SampleSet", init<WordList&, unsigned int, unsigned int>())
+        .def(init<WordList&, unsigned int>())
+        .def(init<>())
+        .def("Draw", &SampleSet::Draw)
+        .def("Samples", &SampleSet::Samples)
+        .def("WordIndex", &SampleSet::WordIndex)
+        .def("FullList", &SampleSet::FullList)
+        .def_pickle(packed_pickle_suite<SampleSet>())
+        .def("SaveToFile", &SaveToFile<SampleSet>)
+        .def("LoadFromFile", &LoadFromFile<SampleSet>)
+    ;
+/********************************************************/
+
+/***************** EvaluationOptions class **************/
+
+    {
+        scope options = class_<EvaluationOptions>("EvaluationOptions")
+            .def_readwrite("efficiency", &EvaluationOptions::efficiency)
+            .def_readwrite("iterations", &EvaluationOptions::iterations)
+            .def_readwrite("possibility_tries", &EvaluationOptions::possibility_tries)
+            .def_readwrite("exp_par", &EvaluationOptions::exp_par)
+            .def_readwrite("precision", &EvaluationOptions::precision,
+                "The precision Fast compares perfect vectors at.  Ignored when epsilon is above 0.")
+            .def_readwrite("epsilon", &EvaluationOptions::epsilon,
+                "Above 0, Fast is computed to within epsilon by TruncatedFastEfficiency at full precision, whatever precision is.")
+            .def_readwrite("threads", &EvaluationOptions::threads)
+            .def_readwrite("seed", &EvaluationOptions::seed)
+            .def_readwrite("block", &EvaluationOptions::block)
+        ;
+
+        enum_<EvaluationOptions::Efficiency>("Efficiency")
+            .value("MonteCarlo", EvaluationOptions::MonteCarlo)
+            .value("Fast", EvaluationOptions::Fast)
+            .value("RadixMonteCarlo", EvaluationOptions::RadixMonteCarlo)
+        ;
+    }
+/********************************************************/
+
+/***************** PerfectVectorStore class *************/
+
+    {
+        scope store = class_<PerfectVectorStore>("PerfectVectorStore", init<PerfectVectorStore::Precision>())
+            .def(init<>())
+            .def("Build", PerfectVectorStoreBuild)
+            .def("GetPrecision", &PerfectVectorStore::GetPrecision)
+            .def("Vectors", &PerfectVectorStore::Vectors)
+            .def("Points", &PerfectVectorStore::Points)
+            .def("Bytes", &PerfectVectorStore::Bytes)
+            .def("Distances", &PerfectVectorStoreDistances)
+            .def("Distances", &PerfectVectorStoreDistances1)
+            .def("Nearest", &PerfectVectorStore::Nearest)
+            .def("Validate", &PerfectVectorStore::Validate)
+            .staticmethod("Validate")
+        ;
+
+        enum_<PerfectVectorStore::Precision>("Precision")
+            .value("Double", PerfectVectorStore::Double)
+            .value("Float", PerfectVectorStore::Float)
+            .value("Int16", PerfectVectorStore::Int16)
+        ;
+    }
+
+    class_<PrecisionReport>("PrecisionReport")
+        .def_readonly("samples", &PrecisionReport::samples)
+        .def_readonly("changed", &PrecisionReport::changed)
+        .def_readonly("max_error", &PrecisionReport::max_error)
+        .def_readonly("mean_error", &PrecisionReport::mean_error)
+        .def("ChangeRate", &PrecisionReport::ChangeRate)
+    ;
+/********************************************************/
+
+/***************** FitnessCache class *******************/
+
+    class_<FitnessCache, boost::noncopyable>("FitnessCache", init<unsigned int>())
+        .def(init<>())
+        .def("Lookup", &FitnessCacheLookup)
+        .def("Add", &FitnessCacheAdd)
+        .def("Size", &FitnessCache::Size)
+        .def("Capacity", &FitnessCache::Capacity)
+        .def("SetCapacity", &FitnessCache::SetCapacity)
+        .def("Hits", &FitnessCache::Hits)
+        .def("Misses", &FitnessCache::Misses)
+        .def("Clear", &FitnessCache::Clear)
+        .def("Context", &FitnessCache::Context)
+        .staticmethod("Context")
+    ;
+/********************************************************/
+
 /***************** FitnessFunctions ********************/
-    def("MonteCarloEfficiency", &FitnessFunctions::MonteCarloEfficiency);
-    def("FastEfficiency", &FitnessFunctions::FastEfficiency);
-    def("RadixMonteCarloEfficiency", &FitnessFunctions::RadixMonteCarloEfficiency);
+    def("MonteCarloEfficiency", MonteCarloEfficiency1);
+    def("MonteCarloEfficiency", MonteCarloEfficiency2);
+    def("MonteCarloEfficiencyDifference", &FitnessFunctions::MonteCarloEfficiencyDifference);
+    def("StratifiedMonteCarloEfficiency", &FitnessFunctions::StratifiedMonteCarloEfficiency);
+    def("LengthStratifiedMonteCarloEfficiency", &FitnessFunctions::LengthStratifiedMonteCarloEfficiency);
+    def("ImportanceMonteCarloEfficiency", ImportanceMonteCarloEfficiency1);
+    def("ImportanceMonteCarloEfficiency", ImportanceMonteCarloEfficiency2);
+    def("FastEfficiency", FastEfficiency1);
+    def("FastEfficiency", FastEfficiency2);
+    def("TruncatedFastEfficiency", TruncatedFastEfficiency1);
+    def("RadixMonteCarloEfficiency", RadixMonteCarloEfficiency1);
+    def("Confusions", &FitnessFunctions::Confusions, Confusions_overloads());
+    def("EvaluateKeyboards", &EvaluateKeyboardList);
+    def("EvaluateKeyboards", &EvaluateCachedKeyboardList);
+/********************************************************/
+
+/***************** Instrumentation **********************/
+    def("InstrumentationEnabled", &Instrumentation::Enabled);
+    def("InstrumentationStats", &InstrumentationAggregate);
+    def("ResetInstrumentation", &Instrumentation::Reset);
+/********************************************************/
+
+/***************** Tracing ******************************/
+    class_<TraceSpan, boost::noncopyable>("TraceSpan", init<std::string, std::string>())
+        .def("Begin", &TraceSpan::Begin)
+        .def("End", &TraceSpan::End)
+        .def("SetKeyboard", &TraceSpan::SetKeyboard)
+        .def("SetFitness", &TraceSpan::SetFitness)
+        .def("__enter__", &TraceSpanEnter)
+        .def("__exit__", &TraceSpanExit)
+    ;
+    def("EnableTracing", &Tracing::Enable);
+    def("EnableTracing", &EnableTracing1);
+    def("DisableTracing", &Tracing::Disable);
+    def("TracingEnabled", &Tracing::Enabled);
+    def("ClearTrace", &Tracing::Clear);
+    def("ChromeTrace", &Tracing::ChromeTraceJson);
+    def("DumpTrace", &Tracing::Dump);
 /********************************************************/
 
 /***************** Interpolation ************************/
-    def("SpatialInterpolation", &SpatialInterpolation);
-    def("MonotonicCubicSplineInterpolation", &MonotonicCubicSplineInterpolation);
-    def("HermiteCubicSplineInterpolation", &HermiteCubicSplineInterpolation);
-    def("CubicSplineInterpolation", &CubicSplineInterpolation);
-    def("ModCubicSplineInterpolation", &ModCubicSplineInterpolation);
-    def("BezierInterpolation", &BezierInterpolation);
-    def("BezierSloppyInterpolation", &BezierSloppyInterpolation);
+    def("SpatialInterpolation", SpatialInterpolation1);
+    def("MonotonicCubicSplineInterpolation", MonotonicCubicSplineInterpolation1);
+    def("HermiteCubicSplineInterpolation", HermiteCubicSplineInterpolation1);
+    def("CubicSplineInterpolation", CubicSplineInterpolation1);
+    def("ModCubicSplineInterpolation", ModCubicSplineInterpolation1);
+    def("BezierInterpolation", BezierInterpolation1);
+    def("BezierSloppyInterpolation", BezierSloppyInterpolation1);
 /********************************************************/
 
 /************** DataFormat ******************/
@@ -248,7 +511,7 @@ BOOST_PYTHON_MODULE(core)
         .def("AddEntry", &DataFormat::AddEntry)
         .def("GetEntry", &DataFormat::GetEntry)
         .def("Entries", &DataFormat::Entries)
-        .def_pickle(serialization_pickle_suite<DataFormat>())
+        .def_pickle(packed_pickle_suite<DataFormat>())
         .def("SaveToFile", &SaveToFile<DataFormat>)
         .def("PythonData", &DataFormatPythonForm)
         .def("LoadFromFile", &LoadFromFile<DataFormat>)
@@ -264,9 +527,97 @@ BOOST_PYTHON_MODULE(core)
     ;
 /********************************************************/
 
+/************** ResultsLog ******************/
+    class_<ResultsLogWriter, boost::noncopyable>("ResultsLogWriter", init<std::string, DataFormat&, unsigned int>())
+        .def(init<std::string, DataFormat&>())
+        .def(init<std::string, unsigned int>())
+        .def(init<std::string>())
+        .def("Good", &ResultsLogWriter::Good)
+        .def("Add", &ResultsLogWriter::Add)
+        .def("Flush", &ResultsLogWriter::Flush)
+        .def("Entries", &ResultsLogWriter::Entries)
+    ;
+
+    class_<ResultsLogReader, boost::noncopyable>("ResultsLogReader", init<std::string>())
+        .def("Good", &ResultsLogReader::Good)
+        .def("Metadata", &ResultsLogReader::Metadata)
+        .def("Next", &ResultsLogReaderNext)
+        .def("Rewind", &ResultsLogReader::Rewind)
+        .def("__iter__", &ResultsLogPassThrough)
+        .def("__next__", &ResultsLogReaderNext)
+    ;
+
+    class_<ResultsLogIndex, boost::noncopyable>("ResultsLogIndex", init<std::string>())
+        .def("Good", &ResultsLogIndex::Good)
+        .def("Size", &ResultsLogIndex::Size)
+        .def("Lookup", &ResultsLogIndexLookup)
+    ;
+
+    def("MergeResultsLogs", &ResultsLog::Merge);
+    def("ReadResultsLog", &ResultsLog::ReadDataFormat);
+    def("WriteResultsLog", &ResultsLog::WriteDataFormat);
+/********************************************************/
+
+/************** ResultsTable ******************/
+    class_<ResultsTable>("ResultsTable", init<>())
+        .def(init<DataFormat&>())
+        .def("Add", &ResultsTableAdd)
+        .def("AddDataFormat", &ResultsTableAddDataFormat)
+        .def("AddResultsLog", &ResultsTableAddResultsLog)
+        .def("Rows", &ResultsTable::Rows)
+        .def("Layouts", &ResultsTable::Layouts)
+        .def("Characters", &ResultsTable::Characters)
+        .def("Polygons", &ResultsTable::Polygons)
+        .def("GetPolygon", &ResultsTable::GetPolygon)
+        .def("EfficiencyTypes", &ResultsTableEfficiencyTypes)
+        .def("GetKeyboard", &ResultsTable::GetKeyboard)
+        .def("GetWordListName", &ResultsTable::GetWordListName)
+        .def("GetInputModelName", &ResultsTable::GetInputModelName)
+        .def("GetDistanceMeasureName", &ResultsTable::GetDistanceMeasureName)
+        .def("LayoutArray", &ResultsTableLayouts)
+        .def("Columns", &ResultsTableColumns)
+        .def("Save", &ResultsTable::Save)
+        .def("Load", &ResultsTableLoad)
+    ;
+/********************************************************/
+
+/***************** NGramModel class *********************/
+    class_<NGramModel>("NGramModel", init<unsigned int>())
+        .def(init<>())
+        .def("AddWords", &NGramModelAddWords)
+        .def("IngestFiles", &NGramModelIngestFiles)
+        .def("IngestFiles", &NGramModelIngestFiles1)
+        .def("Prepare", &NGramModel::Prepare)
+        .def("Order", &NGramModel::Order)
+        .def("VocabularySize", &NGramModel::VocabularySize)
+        .def("TotalWords", &NGramModel::TotalWords)
+        .def("NGrams", &NGramModel::NGrams)
+        .def("Probability", &NGramModelProbability)
+        .def("Save", &NGramModel::Save)
+        .def("Load", &NGramModel::Load)
+    ;
+/********************************************************/
+
+/***************** ContextDecoder class *****************/
+    class_<DecodingReport>("DecodingReport")
+        .def_readonly("words", &DecodingReport::words)
+        .def_readonly("correct", &DecodingReport::correct)
+        .def_readonly("baseline_correct", &DecodingReport::baseline_correct)
+        .def("Accuracy", &DecodingReport::Accuracy)
+        .def("BaselineAccuracy", &DecodingReport::BaselineAccuracy)
+    ;
+
+    class_<ContextDecoder>("ContextDecoder")
+        .def_readwrite("distance_weight", &ContextDecoder::distance_weight)
+        .def_readwrite("lm_weight", &ContextDecoder::lm_weight)
+        .def_readwrite("beam", &ContextDecoder::beam)
+        .def("BestMatch", &ContextDecoderBestMatch)
+        .def("Decode", &ContextDecoderDecode)
+        .def("Accuracy", &ContextDecoderAccuracy)
+    ;
+/********************************************************/
+
 /***************** Neural Network Static Functions ******/
-#ifndef NO_FANN
     def("CreateNeuralNetworkInputs", &CreateNeuralNetworkInputs);
-#endif
 /********************************************************/
 }
@@ -1,4 +1,5 @@
 #include "RadixTree.h"
+#include "Instrumentation.h"
 
 #include "string.h"
 #include <utility>
@@ -17,7 +18,7 @@ RadixTree::~RadixTree() {
 }
 
 // make the first and last letters the first two nodes
-char* RadixTree::ArrangeWord(const char* word) {
+char* RadixTree::ArrangeWord(const char* word) const {
     const unsigned int length = strlen(word);
     char *newword = new char [length+1];
     strcpy(newword, word);
@@ -53,7 +54,7 @@ bool RadixTree::AddWord(const char* word) {
     return newnode;
 }
 
-bool RadixTree::CheckWord(const char* word) {
+bool RadixTree::CheckWord(const char* word) const {
     char *newword = ArrangeWord(word);
     unsigned char index = (unsigned char) newword[0];
     if(nodes[index] == 0) {
@@ -96,7 +97,7 @@ void StripDuplicates(char *stringform) {
     stringform[unique] = stringform[length];
 }
 
-vector<string> RadixTree::Matches(const char* stringform) {
+vector<string> RadixTree::Matches(const char* stringform) const {
     vector<string> matches;
     unsigned int length = strlen(stringform);
 
@@ -121,11 +122,12 @@ vector<string> RadixTree::Matches(const char* stringform) {
         }
     }
 
+    DODONA_COUNT(RadixMatches, matches.size());
     return matches;
 }
 
 //first letters are already taken care of, we just need to make sure we're consistent
-vector<string> RadixTree::MatchesHelper(const char* stringform, bool termination) {
+vector<string> RadixTree::MatchesHelper(const char* stringform, bool termination) const {
     vector<string> matches;
     unsigned int length = strlen(stringform);
 
@@ -0,0 +1,325 @@
+#include "ResultsLog.h"
+#include "Hashing.h"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    const char magic[8] = {'D', 'O', 'D', 'O', 'L', 'O', 'G', '\0'};
+    const uint32_t log_version = 1;
+    const char metadata_record = 'M';
+    const char chunk_record = 'R';
+
+    void WriteFileHeader(ostream& out) {
+        out.write(magic, sizeof(magic));
+        out.write((const char*) &log_version, sizeof(log_version));
+    }
+
+    bool ReadFileHeader(istream& in) {
+        char m[sizeof(magic)];
+        uint32_t version = 0;
+        in.read(m, sizeof(m));
+        in.read((char*) &version, sizeof(version));
+        return in.good() && memcmp(m, magic, sizeof(magic)) == 0 && version == log_version;
+    }
+
+    //type, payload length, payload checksum, payload
+    void WriteRecord(ostream& out, char type, const string& payload) {
+        const uint32_t length = payload.size();
+        const uint64_t check = HashBytes(payload.data(), payload.size());
+        out.write(&type, 1);
+        out.write((const char*) &length, sizeof(length));
+        out.write((const char*) &check, sizeof(check));
+        out.write(payload.data(), payload.size());
+    }
+
+    //the bytes between the read position and the end of the file
+    streamoff Remaining(istream& in) {
+        const streampos position = in.tellg();
+        in.seekg(0, ios::end);
+        const streampos end = in.tellg();
+        in.seekg(position);
+        return position < 0 || end < 0 ? 0 : streamoff(end - position);
+    }
+
+    //false at the end of the file or at a record that was cut short or corrupted.  A length running
+    //past the end of the file is taken as a cut short record rather than trusted.
+    bool ReadRecord(istream& in, char& type, string& payload) {
+        uint32_t length = 0;
+        uint64_t check = 0;
+        in.read(&type, 1);
+        in.read((char*) &length, sizeof(length));
+        in.read((char*) &check, sizeof(check));
+        if(!in.good() || streamoff(length) > Remaining(in)) return false;
+        payload.resize(length);
+        if(length > 0) in.read(&payload[0], length);
+        return !in.fail() && HashBytes(payload.data(), payload.size()) == check;
+    }
+
+    template<typename T> string Pack(const T& o) {
+        ostringstream os;
+        {
+            boost::archive::binary_oarchive oa(os);
+            oa << o;
+        }
+        return os.str();
+    }
+
+    template<typename T> bool Unpack(T& o, const string& payload) {
+        try {
+            istringstream is(payload);
+            boost::archive::binary_iarchive ia(is);
+            ia >> o;
+        }
+        catch(boost::archive::archive_exception& e) {
+            return false;
+        }
+        return true;
+    }
+
+    bool SameMetadata(DataFormat& a, DataFormat& b) {
+        if(a.GetWordListName() != b.GetWordListName()) {
+            cerr << "ERROR: These two results logs do not use the same word list." << endl;
+            return false;
+        }
+        if(a.GetInputModelName() != b.GetInputModelName()) {
+            cerr << "ERROR: These two results logs do not use the same input model." << endl;
+            return false;
+        }
+        if(a.GetDistanceMeasureName() != b.GetDistanceMeasureName()) {
+            cerr << "ERROR: These two results logs do not use the same distance measure." << endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+ResultsLogWriter::ResultsLogWriter(const string& filename, DataFormat& format, unsigned int chunk) {
+    chunk_entries = max(chunk, 1u);
+    written = 0;
+    file.open(filename.c_str(), ios::binary | ios::trunc);
+    if(!file.is_open()) {
+        cerr << "ERROR: Unable to create the results log " << filename << "." << endl;
+        return;
+    }
+
+    WordList wl = format.GetWordList();
+    DataFormat metadata(wl, format.GetWordListName(), format.GetInputModelName(), format.GetDistanceMeasureName());
+    WriteFileHeader(file);
+    WriteRecord(file, metadata_record, Pack(metadata));
+
+    for(unsigned int i = 0; i < format.Entries(); i++) {
+        DataFormat::resultEntry entry = format.GetEntry(i);
+        for(unsigned int j = 0; j < entry.second.size(); j++) {
+            Add(entry.first, entry.second[j].first, entry.second[j].second);
+        }
+    }
+    Flush();
+}
+
+ResultsLogWriter::ResultsLogWriter(const string& filename, unsigned int chunk) {
+    chunk_entries = max(chunk, 1u);
+    written = 0;
+
+    //find the end of the last complete record so a partially written chunk gets dropped
+    streamoff valid_end = 0;
+    bool has_metadata = false;
+    {
+        ifstream in(filename.c_str(), ios::binary);
+        if(!ReadFileHeader(in)) {
+            cerr << "ERROR: " << filename << " is not a results log." << endl;
+            return;
+        }
+        char type;
+        string payload;
+        while(ReadRecord(in, type, payload)) {
+            has_metadata = has_metadata || type == metadata_record;
+            valid_end = in.tellg();
+        }
+    }
+    if(!has_metadata) {
+        cerr << "ERROR: The results log " << filename << " has no metadata." << endl;
+        return;
+    }
+    if(truncate(filename.c_str(), valid_end) != 0) {
+        cerr << "ERROR: Unable to drop the incomplete end of " << filename << "." << endl;
+        return;
+    }
+    file.open(filename.c_str(), ios::binary | ios::app);
+}
+
+ResultsLogWriter::~ResultsLogWriter() {
+    Flush();
+}
+
+void ResultsLogWriter::Add(Keyboard& k, string effType, FitnessResult eff) {
+    pending.push_back(ResultsLogEntry(k, effType, eff));
+    if(pending.size() >= chunk_entries) {
+        Flush();
+    }
+}
+
+void ResultsLogWriter::Flush() {
+    if(!file.is_open()) return;
+    if(pending.size() > 0) {
+        WriteRecord(file, chunk_record, Pack(pending));
+        written += pending.size();
+        pending.clear();
+    }
+    file.flush();
+}
+
+ResultsLogReader::ResultsLogReader(const string& filename) {
+    good = false;
+    data_start = chunk_offset = 0;
+    position = 0;
+    file.open(filename.c_str(), ios::binary);
+    if(!ReadFileHeader(file)) {
+        cerr << "ERROR: " << filename << " is not a results log." << endl;
+        return;
+    }
+    char type;
+    string payload;
+    if(!ReadRecord(file, type, payload) || type != metadata_record || !Unpack(metadata, payload)) {
+        cerr << "ERROR: The results log " << filename << " has no metadata." << endl;
+        return;
+    }
+    data_start = file.tellg();
+    good = true;
+}
+
+bool ResultsLogReader::NextChunk() {
+    char type;
+    string payload;
+    while(good && file.good()) {
+        const streamoff offset = file.tellg();
+        if(!ReadRecord(file, type, payload)) return false;
+        if(type != chunk_record) continue;
+        chunk.clear();
+        if(!Unpack(chunk, payload)) return false;
+        chunk_offset = offset;
+        position = 0;
+        return true;
+    }
+    return false;
+}
+
+bool ResultsLogReader::Next(ResultsLogEntry& entry) {
+    while(position >= chunk.size()) {
+        if(!NextChunk()) return false;
+    }
+    entry = chunk[position++];
+    return true;
+}
+
+void ResultsLogReader::Rewind() {
+    file.clear();
+    file.seekg(data_start);
+    chunk.clear();
+    position = 0;
+}
+
+bool ResultsLogReader::ReadChunk(istream& in, streamoff offset, vector<ResultsLogEntry>& entries) {
+    char type;
+    string payload;
+    in.clear();
+    in.seekg(offset);
+    entries.clear();
+    return ReadRecord(in, type, payload) && type == chunk_record && Unpack(entries, payload);
+}
+
+ResultsLogIndex::ResultsLogIndex(const string& filename) {
+    ResultsLogReader reader(filename);
+    good = reader.Good();
+    ResultsLogEntry entry;
+    while(reader.Next(entry)) {
+        locations.insert(make_pair(entry.keyboard.Hash(), location(reader.ChunkOffset(), reader.ChunkPosition())));
+    }
+    file.open(filename.c_str(), ios::binary);
+}
+
+vector<ResultsLogEntry> ResultsLogIndex::Lookup(Keyboard& k) {
+    typedef boost::unordered_multimap<uint64_t, location>::iterator index_iterator;
+    pair<index_iterator, index_iterator> range = locations.equal_range(k.Hash());
+    vector<location> found;
+    for(index_iterator it = range.first; it != range.second; it++) {
+        found.push_back(it->second);
+    }
+    sort(found.begin(), found.end());
+
+    vector<ResultsLogEntry> results, entries;
+    streamoff loaded = -1;
+    for(unsigned int i = 0; i < found.size(); i++) {
+        if(found[i].first != loaded) {
+            if(!ResultsLogReader::ReadChunk(file, found[i].first, entries)) continue;
+            loaded = found[i].first;
+        }
+        if(found[i].second < entries.size() && entries[found[i].second].keyboard == k) {
+            results.push_back(entries[found[i].second]);
+        }
+    }
+    return results;
+}
+
+bool ResultsLog::Merge(const string& first, const string& second, const string& output) {
+    if(output == first || output == second) {
+        cerr << "ERROR: The merged results log has to be written to a new file." << endl;
+        return false;
+    }
+    DataFormat metadata;
+    {
+        ResultsLogReader a(first), b(second);
+        if(!a.Good() || !b.Good()) return false;
+        DataFormat ma = a.Metadata(), mb = b.Metadata();
+        if(!SameMetadata(ma, mb)) return false;
+        metadata = ma;
+    }
+
+    ofstream out(output.c_str(), ios::binary | ios::trunc);
+    if(!out.is_open()) {
+        cerr << "ERROR: Unable to create the results log " << output << "." << endl;
+        return false;
+    }
+    WriteFileHeader(out);
+    WriteRecord(out, metadata_record, Pack(metadata));
+
+    //the chunks are copied as they are, one at a time, without decoding them
+    const string inputs[2] = {first, second};
+    for(unsigned int i = 0; i < 2; i++) {
+        ifstream in(inputs[i].c_str(), ios::binary);
+        ReadFileHeader(in);
+        char type;
+        string payload;
+        while(ReadRecord(in, type, payload)) {
+            if(type == chunk_record) {
+                WriteRecord(out, type, payload);
+            }
+        }
+    }
+    out.flush();
+    return out.good();
+}
+
+DataFormat ResultsLog::ReadDataFormat(const string& filename) {
+    ResultsLogReader reader(filename);
+    DataFormat format = reader.Metadata();
+    ResultsLogEntry entry;
+    while(reader.Next(entry)) {
+        format.AddEntry(entry.keyboard, entry.efficiency, entry.result);
+    }
+    return format;
+}
+
+bool ResultsLog::WriteDataFormat(DataFormat& format, const string& filename) {
+    ResultsLogWriter writer(filename, format);
+    return writer.Good();
+}
@@ -0,0 +1,381 @@
+#include "ResultsTable.h"
+#include "ResultsLog.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string.h>
+
+using namespace std;
+
+namespace {
+    const char magic[8] = {'D', 'O', 'D', 'O', 'C', 'O', 'L', '\0'};
+    const uint32_t table_version = 1;
+    //efficiency types are stored as one byte indices
+    const unsigned int max_types = 256;
+    //polygon indices are stored in two bytes
+    const unsigned int max_polygons = 65536;
+
+    //the columns are written in the machine's byte order, which the dtypes record for numpy
+    string Dtype(const char* kind) {
+        const uint16_t one = 1;
+        const bool little = *(const char*) &one == 1;
+        return string(little ? "<" : ">") + kind;
+    }
+
+    class Column {
+      public:
+        string name, dtype;
+        vector<uint64_t> shape;
+        const char *data;
+        uint64_t bytes, offset;
+
+        Column(const string& n, const string& d, const void* values, uint64_t size, uint64_t rows, uint64_t columns = 0)
+                : name(n), dtype(d), data((const char*) values), bytes(size), offset(0) {
+            shape.push_back(rows);
+            if(columns > 0) shape.push_back(columns);
+        }
+    };
+
+    template<typename T> const void* Data(const vector<T>& values) {
+        return values.size() > 0 ? &values[0] : 0;
+    }
+
+    template<typename T> void Put(string& out, const T& value) {
+        out.append((const char*) &value, sizeof(T));
+    }
+
+    void PutString(string& out, const string& s) {
+        Put(out, (uint32_t) s.size());
+        out.append(s);
+    }
+
+    //reads fields back out of a header, remembering if it ran off the end
+    class Cursor {
+        const string& text;
+        size_t position;
+      public:
+        bool good;
+
+        Cursor(const string& t, size_t start) : text(t), position(start), good(true) {}
+
+        template<typename T> T Get() {
+            T value = T();
+            if(good && position + sizeof(T) <= text.size()) {
+                memcpy(&value, text.data() + position, sizeof(T));
+                position += sizeof(T);
+            }
+            else good = false;
+            return value;
+        }
+
+        string GetString() {
+            const uint32_t length = Get<uint32_t>();
+            if(!good || position + length > text.size()) {
+                good = false;
+                return string();
+            }
+            position += length;
+            return text.substr(position - length, length);
+        }
+    };
+
+    //copies the named column into values if its dtype and item count are as expected
+    template<typename T> bool ReadColumn(const string& file, const vector<Column>& columns, const string& name,
+            const string& dtype, uint64_t items, vector<T>& values) {
+        for(unsigned int i = 0; i < columns.size(); i++) {
+            if(columns[i].name != name) continue;
+            uint64_t count = 1;
+            for(unsigned int j = 0; j < columns[i].shape.size(); j++) count *= columns[i].shape[j];
+            if(columns[i].dtype != dtype || count != items || columns[i].offset + items*sizeof(T) > file.size()) {
+                return false;
+            }
+            values.resize(items);
+            if(items > 0) memcpy(&values[0], file.data() + columns[i].offset, items*sizeof(T));
+            return true;
+        }
+        return false;
+    }
+};
+
+ResultsTable::ResultsTable() {
+}
+
+ResultsTable::ResultsTable(DataFormat& format) {
+    AddDataFormat(format);
+}
+
+int ResultsTable::AddType(const string& effType) {
+    for(unsigned int i = 0; i < types.size(); i++) {
+        if(types[i] == effType) return i;
+    }
+    if(types.size() >= max_types) {
+        cerr << "ERROR: A results table can only hold " << max_types << " efficiency types." << endl;
+        return -1;
+    }
+    types.push_back(effType);
+    return types.size() - 1;
+}
+
+int ResultsTable::AddLayout(Keyboard& k) {
+    if(Rows() == 0 && layouts.size() == 0) {
+        characters.clear();
+        for(unsigned int i = 0; i < k.NKeys(); i++) {
+            characters += k.CharN(i);
+        }
+    }
+    if(k.NKeys() != characters.size()) {
+        cerr << "ERROR: Every keyboard in a results table must have the same characters." << endl;
+        return -1;
+    }
+
+    vector<uint16_t> row(characters.size());
+    vector<Polygon> added;
+    for(unsigned int i = 0; i < characters.size(); i++) {
+        const unsigned char c = characters[i];
+        if(k.CharIndex(c) < 0) {
+            cerr << "ERROR: Every keyboard in a results table must have the same characters." << endl;
+            return -1;
+        }
+        const Polygon p = k.GetKey(c);
+        typedef boost::unordered_multimap<uint64_t, unsigned int>::iterator index_iterator;
+        pair<index_iterator, index_iterator> range = polygon_index.equal_range(p.Hash());
+        int found = -1;
+        for(index_iterator it = range.first; it != range.second && found < 0; it++) {
+            if(it->second < polygons.size() && polygons[it->second] == p) found = it->second;
+        }
+        //polygons new to this keyboard are only kept once it is known to fit
+        for(unsigned int j = 0; j < added.size() && found < 0; j++) {
+            if(added[j] == p) found = polygons.size() + j;
+        }
+        if(found < 0) {
+            found = polygons.size() + added.size();
+            added.push_back(p);
+        }
+        row[i] = found;
+    }
+    if(polygons.size() + added.size() > max_polygons) {
+        cerr << "ERROR: A results table can only hold " << max_polygons << " distinct polygons." << endl;
+        return -1;
+    }
+    for(unsigned int j = 0; j < added.size(); j++) {
+        polygon_index.insert(make_pair(added[j].Hash(), (unsigned int) polygons.size()));
+        polygons.push_back(added[j]);
+    }
+
+    typedef boost::unordered_multimap<uint64_t, unsigned int>::iterator index_iterator;
+    pair<index_iterator, index_iterator> range = layout_index.equal_range(k.Hash());
+    for(index_iterator it = range.first; it != range.second; it++) {
+        if(equal(row.begin(), row.end(), layouts.begin() + it->second*row.size())) {
+            return it->second;
+        }
+    }
+    const unsigned int layout = Layouts();
+    layouts.insert(layouts.end(), row.begin(), row.end());
+    layout_index.insert(make_pair(k.Hash(), layout));
+    return layout;
+}
+
+bool ResultsTable::Add(Keyboard& k, string effType, FitnessResult eff) {
+    const int type = AddType(effType);
+    const int layout = type >= 0 ? AddLayout(k) : -1;
+    if(layout < 0) return false;
+    layout_column.push_back(layout);
+    type_column.push_back(type);
+    fitness_column.push_back(eff.Fitness());
+    error_column.push_back(eff.Error());
+    iterations_column.push_back(eff.Iterations());
+    return true;
+}
+
+bool ResultsTable::AddDataFormat(DataFormat& format) {
+    word_list = format.GetWordListName();
+    input_model = format.GetInputModelName();
+    distance_measure = format.GetDistanceMeasureName();
+    for(unsigned int i = 0; i < format.Entries(); i++) {
+        DataFormat::resultEntry entry = format.GetEntry(i);
+        for(unsigned int j = 0; j < entry.second.size(); j++) {
+            if(!Add(entry.first, entry.second[j].first, entry.second[j].second)) return false;
+        }
+    }
+    return true;
+}
+
+bool ResultsTable::AddResultsLog(const string& filename) {
+    ResultsLogReader reader(filename);
+    if(!reader.Good()) return false;
+    DataFormat metadata = reader.Metadata();
+    word_list = metadata.GetWordListName();
+    input_model = metadata.GetInputModelName();
+    distance_measure = metadata.GetDistanceMeasureName();
+    ResultsLogEntry entry;
+    while(reader.Next(entry)) {
+        if(!Add(entry.keyboard, entry.efficiency, entry.result)) return false;
+    }
+    return true;
+}
+
+Keyboard ResultsTable::GetKeyboard(unsigned int i) const {
+    Keyboard k;
+    for(unsigned int c = 0; c < characters.size() && i < Layouts(); c++) {
+        k.AddKey(characters[c], polygons[layouts[i*characters.size() + c]]);
+    }
+    return k;
+}
+
+bool ResultsTable::Save(const string& filename) const {
+    vector<Column> columns;
+    columns.push_back(Column("layouts", Dtype("u2"), Data(layouts), layouts.size()*sizeof(uint16_t), Layouts(), characters.size()));
+    columns.push_back(Column("layout", Dtype("u4"), Data(layout_column), layout_column.size()*sizeof(uint32_t), Rows()));
+    columns.push_back(Column("efficiency", "|u1", Data(type_column), type_column.size(), Rows()));
+    columns.push_back(Column("fitness", Dtype("f8"), Data(fitness_column), fitness_column.size()*sizeof(double), Rows()));
+    columns.push_back(Column("error", Dtype("f8"), Data(error_column), error_column.size()*sizeof(double), Rows()));
+    columns.push_back(Column("iterations", Dtype("u4"), Data(iterations_column), iterations_column.size()*sizeof(uint32_t), Rows()));
+
+    //the header's length doesn't depend on the offsets so the first pass only measures it
+    string header;
+    for(unsigned int pass = 0; pass < 2; pass++) {
+        header.clear();
+        PutString(header, word_list);
+        PutString(header, input_model);
+        PutString(header, distance_measure);
+        PutString(header, characters);
+        Put(header, (uint32_t) types.size());
+        for(unsigned int i = 0; i < types.size(); i++) {
+            PutString(header, types[i]);
+        }
+        Put(header, (uint32_t) polygons.size());
+        for(unsigned int i = 0; i < polygons.size(); i++) {
+            Put(header, (uint32_t) polygons[i].VertexCount());
+            for(unsigned int j = 0; j < polygons[i].VertexCount(); j++) {
+                Put(header, polygons[i].VertexX(j));
+                Put(header, polygons[i].VertexY(j));
+            }
+        }
+        Put(header, (uint32_t) columns.size());
+        for(unsigned int i = 0; i < columns.size(); i++) {
+            PutString(header, columns[i].name);
+            PutString(header, columns[i].dtype);
+            Put(header, (uint32_t) columns[i].shape.size());
+            for(unsigned int j = 0; j < columns[i].shape.size(); j++) {
+                Put(header, columns[i].shape[j]);
+            }
+            Put(header, columns[i].offset);
+        }
+
+        uint64_t end = sizeof(magic) + 2*sizeof(uint32_t) + header.size();
+        for(unsigned int i = 0; i < columns.size(); i++) {
+            end = (end + 7)/8*8;
+            columns[i].offset = end;
+            end += columns[i].bytes;
+        }
+    }
+
+    ofstream out(filename.c_str(), ios::binary | ios::trunc);
+    if(!out.is_open()) {
+        cerr << "ERROR: Unable to create the results table " << filename << "." << endl;
+        return false;
+    }
+    const uint32_t header_length = header.size();
+    out.write(magic, sizeof(magic));
+    out.write((const char*) &table_version, sizeof(table_version));
+    out.write((const char*) &header_length, sizeof(header_length));
+    out.write(header.data(), header.size());
+    for(unsigned int i = 0; i < columns.size(); i++) {
+        while((uint64_t) out.tellp() < columns[i].offset) out.put('\0');
+        if(columns[i].bytes > 0) out.write(columns[i].data, columns[i].bytes);
+    }
+    out.flush();
+    return out.good();
+}
+
+bool ResultsTable::Load(const string& filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    stringstream buffer;
+    buffer << in.rdbuf();
+    const string file = buffer.str();
+    if(!in || file.size() < sizeof(magic) || memcmp(file.data(), magic, sizeof(magic)) != 0) {
+        cerr << "ERROR: " << filename << " is not a results table." << endl;
+        return false;
+    }
+
+    Cursor cursor(file, sizeof(magic));
+    if(cursor.Get<uint32_t>() != table_version) {
+        cerr << "ERROR: " << filename << " was written by an unsupported version." << endl;
+        return false;
+    }
+    cursor.Get<uint32_t>();
+
+    ResultsTable t;
+    t.word_list = cursor.GetString();
+    t.input_model = cursor.GetString();
+    t.distance_measure = cursor.GetString();
+    t.characters = cursor.GetString();
+    const uint32_t ntypes = cursor.Get<uint32_t>();
+    for(uint32_t i = 0; i < ntypes && cursor.good; i++) {
+        t.types.push_back(cursor.GetString());
+    }
+    const uint32_t npolygons = cursor.Get<uint32_t>();
+    for(uint32_t i = 0; i < npolygons && cursor.good; i++) {
+        Polygon p;
+        const uint32_t vertices = cursor.Get<uint32_t>();
+        for(uint32_t j = 0; j < vertices && cursor.good; j++) {
+            const double x = cursor.Get<double>();
+            p.AddVertex(x, cursor.Get<double>());
+        }
+        t.polygon_index.insert(make_pair(p.Hash(), (unsigned int) t.polygons.size()));
+        t.polygons.push_back(p);
+    }
+    vector<Column> columns;
+    const uint32_t ncolumns = cursor.Get<uint32_t>();
+    for(uint32_t i = 0; i < ncolumns && cursor.good; i++) {
+        const string name = cursor.GetString();
+        const string dtype = cursor.GetString();
+        Column column(name, dtype, 0, 0, 0);
+        column.shape.resize(cursor.Get<uint32_t>());
+        for(unsigned int j = 0; j < column.shape.size() && cursor.good; j++) {
+            column.shape[j] = cursor.Get<uint64_t>();
+        }
+        column.offset = cursor.Get<uint64_t>();
+        columns.push_back(column);
+    }
+
+    uint64_t rows = 0;
+    for(unsigned int i = 0; i < columns.size(); i++) {
+        if(columns[i].name == "fitness" && columns[i].shape.size() > 0) rows = columns[i].shape[0];
+    }
+    uint64_t layout_items = 0;
+    for(unsigned int i = 0; i < columns.size(); i++) {
+        if(columns[i].name == "layouts" && columns[i].shape.size() == 2 && columns[i].shape[1] == t.characters.size()) {
+            layout_items = columns[i].shape[0]*columns[i].shape[1];
+        }
+    }
+    if(!cursor.good
+            || !ReadColumn(file, columns, "layouts", Dtype("u2"), layout_items, t.layouts)
+            || !ReadColumn(file, columns, "layout", Dtype("u4"), rows, t.layout_column)
+            || !ReadColumn(file, columns, "efficiency", "|u1", rows, t.type_column)
+            || !ReadColumn(file, columns, "fitness", Dtype("f8"), rows, t.fitness_column)
+            || !ReadColumn(file, columns, "error", Dtype("f8"), rows, t.error_column)
+            || !ReadColumn(file, columns, "iterations", Dtype("u4"), rows, t.iterations_column)) {
+        cerr << "ERROR: The results table " << filename << " is incomplete or corrupted." << endl;
+        return false;
+    }
+    bool indices = true;
+    for(unsigned int i = 0; i < t.layouts.size(); i++) {
+        indices = indices && t.layouts[i] < t.polygons.size();
+    }
+    for(unsigned int i = 0; i < rows; i++) {
+        indices = indices && t.layout_column[i] < t.Layouts() && t.type_column[i] < t.types.size();
+    }
+    if(!indices) {
+        cerr << "ERROR: The results table " << filename << " refers to layouts, polygons or efficiency types it doesn't have." << endl;
+        return false;
+    }
+
+    for(unsigned int i = 0; i < t.Layouts(); i++) {
+        Keyboard k = t.GetKeyboard(i);
+        t.layout_index.insert(make_pair(k.Hash(), i));
+    }
+    *this = t;
+    return true;
+}
@@ -0,0 +1,164 @@
+#include "SampleSet.h"
+#include "PackedState.h"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/discrete_distribution.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <iostream>
+#include <string.h>
+using namespace std;
+
+namespace {
+    const char state_magic[8] = "DODOSMP";
+    const uint32_t state_version = 1;
+}
+
+SampleSet::SampleSet() {
+    list_words = 0;
+    list_fingerprint = 0;
+    full_list = false;
+    starts.push_back(0);
+}
+
+SampleSet::SampleSet(WordList& words, unsigned int samples, unsigned int seed) {
+    Draw(words, samples, seed);
+}
+
+void SampleSet::Draw(WordList& words, unsigned int samples, unsigned int seed) {
+    indices.clear();
+    starts.clear();
+    offsets.clear();
+
+    list_words = words.Words();
+    list_fingerprint = words.Fingerprint();
+    full_list = (samples == 0);
+    if(full_list) {
+        samples = list_words;
+    }
+
+    boost::mt19937 generator(seed);
+    boost::normal_distribution<> nd(0.0, 1.0);
+    boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > normal(generator, nd);
+
+    //a private distribution so that drawing samples never disturbs the word list's own generator
+    vector<unsigned int> occurances(list_words);
+    for(unsigned int i = 0; i < list_words; i++) {
+        occurances[i] = words.Occurances(i);
+    }
+    boost::random::discrete_distribution<> distribution(occurances);
+
+    indices.reserve(samples);
+    starts.reserve(samples+1);
+    starts.push_back(0);
+    for(unsigned int i = 0; i < samples && list_words > 0; i++) {
+        const unsigned int index = full_list ? i : distribution(generator);
+        //two offsets per letter in the same order SimpleGaussianModel::RandomVector draws them
+        const unsigned int count = 2*strlen(words.Word(index));
+        for(unsigned int j = 0; j < count; j++) {
+            offsets.push_back(normal());
+        }
+        indices.push_back(index);
+        starts.push_back(offsets.size());
+    }
+}
+
+const double* SampleSet::Offsets(const unsigned int i) const {
+    if(starts[i+1] == starts[i]) {
+        return 0;
+    }
+    return &offsets[starts[i]];
+}
+
+bool SampleSet::CheckList(WordList& words) const {
+    if(list_words != words.Words()) {
+        cerr << "ERROR: The sample set was drawn from a word list with " << list_words;
+        cerr << " words but this word list has " << words.Words() << "." << endl;
+        return false;
+    }
+    if(list_fingerprint != 0 && list_fingerprint != words.Fingerprint()) {
+        cerr << "ERROR: The sample set was drawn from a word list with different words or counts." << endl;
+        return false;
+    }
+    return true;
+}
+
+string SampleSet::PackState() const {
+    StateWriter state(state_magic, state_version);
+    state.Reserve(12 + 4*indices.size() + 4*starts.size() + 8*offsets.size() + 13);
+    state.PutU32(indices.size());
+    for(unsigned int i = 0; i < indices.size(); i++) {
+        state.PutU32(indices[i]);
+    }
+    state.PutU32(starts.size());
+    for(unsigned int i = 0; i < starts.size(); i++) {
+        state.PutU32(starts[i]);
+    }
+    state.PutU64(offsets.size());
+    for(unsigned int i = 0; i < offsets.size(); i++) {
+        state.PutDouble(offsets[i]);
+    }
+    state.PutU32(list_words);
+    state.PutU8(full_list);
+    state.PutU64(list_fingerprint);
+    return state.State();
+}
+
+bool SampleSet::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    uint32_t n = 0;
+    if(!state.GetU32(n) || !state.Fits(n, 4)) {
+        return false;
+    }
+    vector<unsigned int> read_indices(n);
+    for(unsigned int i = 0; i < n; i++) {
+        uint32_t index = 0;
+        state.GetU32(index);
+        read_indices[i] = index;
+    }
+    if(!state.GetU32(n) || !state.Fits(n, 4)) {
+        return false;
+    }
+    vector<unsigned int> read_starts(n);
+    for(unsigned int i = 0; i < n; i++) {
+        uint32_t start = 0;
+        state.GetU32(start);
+        read_starts[i] = start;
+    }
+    uint64_t noffsets = 0;
+    if(!state.GetU64(noffsets) || !state.Fits(noffsets, 8)) {
+        return false;
+    }
+    vector<double> read_offsets(noffsets);
+    for(unsigned int i = 0; i < noffsets; i++) {
+        state.GetDouble(read_offsets[i]);
+    }
+    uint32_t words = 0;
+    uint8_t full = 0;
+    uint64_t fingerprint = 0;
+    state.GetU32(words);
+    state.GetU8(full);
+    state.GetU64(fingerprint);
+    if(!state.Finished()) {
+        return false;
+    }
+
+    //every sample's offsets have to be in range, and every word in the list
+    if(read_starts.size() != read_indices.size() + 1 || read_starts[0] != 0 || read_starts.back() != read_offsets.size()) {
+        return false;
+    }
+    for(unsigned int i = 0; i < read_indices.size(); i++) {
+        if(read_starts[i+1] < read_starts[i] || read_indices[i] >= words) {
+            return false;
+        }
+    }
+
+    indices.swap(read_indices);
+    starts.swap(read_starts);
+    offsets.swap(read_offsets);
+    list_words = words;
+    full_list = full != 0;
+    list_fingerprint = fingerprint;
+    return true;
+}
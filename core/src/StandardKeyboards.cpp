@@ -0,0 +1,116 @@
+#include "StandardKeyboards.h"
+
+#include <iostream>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    const double width = 1.0, height = 1.5, gap = 0.2;
+
+    //key i of a row of rectangular keys whose first key's top left corner is at (startx, starty), with
+    //the arithmetic in the same order as keyboards.py so that the vertices come out identical
+    Polygon RowKey(double startx, double starty, unsigned int i) {
+        Polygon p;
+        p.AddVertex(startx + double(i)*(width+gap), starty);
+        p.AddVertex(startx + double(i)*(width+gap) + width, starty);
+        p.AddVertex(startx + double(i)*(width+gap) + width, starty-height);
+        p.AddVertex(startx + double(i)*(width+gap), starty-height);
+        return p;
+    }
+
+    void AddRow(vector<Polygon>& keys, double startx, double starty, unsigned int n) {
+        for(unsigned int i = 0; i < n; i++) keys.push_back(RowKey(startx, starty, i));
+    }
+
+    //puts the first n characters of alphabet on the first n keys
+    Keyboard Assign(const vector<Polygon>& keys, const char *alphabet, unsigned int n, const char *name) {
+        Keyboard k;
+        if(n > keys.size() || strlen(alphabet) < n) {
+            cerr << "ERROR: The " << name << " keyboard has " << keys.size() << " keys but was given " << strlen(alphabet) << " characters." << endl;
+            return k;
+        }
+        for(unsigned int i = 0; i < n; i++) k.AddKey(alphabet[i], keys[i]);
+        return k;
+    }
+};
+
+Keyboard StandardKeyboards::Qwerty(const char *alphabet) {
+    vector<Polygon> keys;
+    double startx = 0.0, starty = 0.0;
+    AddRow(keys, startx, starty, 10);
+    startx += 0.5*width;
+    starty -= height + gap;
+    AddRow(keys, startx, starty, 9);
+    startx += width + gap;
+    starty -= height + gap;
+    AddRow(keys, startx, starty, 7);
+    starty -= height + gap;
+    keys.push_back(RowKey(startx, starty, 6));
+    return Assign(keys, alphabet, strlen(alphabet), "standard");
+}
+
+Keyboard StandardKeyboards::Dvorak(const char *alphabet) {
+    vector<Polygon> keys;
+    double startx = 1.5*(width+gap), starty = 0.0;
+    AddRow(keys, startx, starty, 8);
+    startx = 0.0;
+    starty -= height + gap;
+    AddRow(keys, startx, starty, 10);
+    startx = 1.5*(width+gap);
+    starty -= height + gap;
+    AddRow(keys, startx, starty, 9);
+    starty -= height + gap;
+    keys.push_back(RowKey(startx, starty, 6));
+    return Assign(keys, alphabet, strlen(alphabet), "Dvorak");
+}
+
+Keyboard StandardKeyboards::Hexagonal(const char *alphabet, double scale) {
+    const double shiftx = sqrt(3.0), shifty = -1.5;
+    const double a = scale, b = scale/2.0, c = sqrt(3.0)*scale/2;
+    Polygon h;
+    h.AddVertex(0, -a);
+    h.AddVertex(c, -b);
+    h.AddVertex(c, b);
+    h.AddVertex(0, a);
+    h.AddVertex(-c, b);
+    h.AddVertex(-c, -b);
+    h.Translate(-shiftx/2.0, 0);
+
+    vector<Polygon> keys;
+    for(unsigned int j = 0; j < 3; j++) {
+        Polygon p(h);
+        for(unsigned int i = 0; i < 10 - j; i++) {
+            p.Translate(shiftx, 0);
+            keys.push_back(p);
+        }
+        h.Translate(0.5*shiftx, shifty);
+    }
+    return Assign(keys, alphabet, keys.size(), "hexagonal");
+}
+
+Keyboard StandardKeyboards::T9(const char *alphabet, double scale) {
+    const double pad = (1.0-scale)/2.0;
+    Polygon h;
+    h.AddVertex(pad, -pad);
+    h.AddVertex(1-pad, -pad);
+    h.AddVertex(1-pad, pad-1);
+    h.AddVertex(pad, pad-1);
+    h.Translate(-2.5, 1.5);
+
+    //the 1 key has no letters, 7 and 9 have four and the rest three
+    vector<Polygon> keys;
+    for(unsigned int j = 0; j < 3; j++) {
+        Polygon p(h);
+        for(unsigned int i = 0; i < 3; i++) {
+            p.Translate(1, 0);
+            if(i == 0 && j == 0) continue;
+            const unsigned int letters = (j == 2 && i != 1) ? 4 : 3;
+            for(unsigned int l = 0; l < letters; l++) keys.push_back(p);
+        }
+        h.Translate(0, -1);
+    }
+    return Assign(keys, alphabet, keys.size(), "T9");
+}
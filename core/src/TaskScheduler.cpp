@@ -0,0 +1,111 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace {
+    //the tasks a thread still has to run, [front, back).  Its owner takes them from the front and
+    //thieves from the back, so whatever a thread holds is always one contiguous run.
+    class TaskRange {
+      public:
+        mutex lock;
+        unsigned int front, back;
+
+        TaskRange() : front(0), back(0) {}
+        unsigned int Size() {
+            lock_guard<mutex> guard(lock);
+            return back - front;
+        }
+        bool Pop(unsigned int& task) {
+            lock_guard<mutex> guard(lock);
+            if(front == back) return false;
+            task = front++;
+            return true;
+        }
+    };
+
+    //moves the back half of the longest run into the thief's own, returning false once every run is empty
+    bool Steal(vector<TaskRange>& ranges, unsigned int thief) {
+        for(;;) {
+            unsigned int victim = thief, longest = 0;
+            for(unsigned int t = 0; t < ranges.size(); t++) {
+                const unsigned int size = t == thief ? 0 : ranges[t].Size();
+                if(size > longest) {
+                    victim = t;
+                    longest = size;
+                }
+            }
+            //tasks never add tasks, so nothing can turn up later
+            if(longest == 0) return false;
+
+            unsigned int front, back;
+            {
+                lock_guard<mutex> guard(ranges[victim].lock);
+                TaskRange& v = ranges[victim];
+                //it may have been emptied since it was measured
+                if(v.front == v.back) continue;
+                back = v.back;
+                front = v.back - max((v.back - v.front)/2, 1u);
+                v.back = front;
+            }
+            lock_guard<mutex> guard(ranges[thief].lock);
+            ranges[thief].front = front;
+            ranges[thief].back = back;
+            return true;
+        }
+    }
+};
+
+TaskScheduler::TaskScheduler(unsigned int t) {
+    threads = t > 0 ? t : thread::hardware_concurrency();
+    threads = max(threads, 1u);
+}
+
+void TaskScheduler::Run(unsigned int n, const function<void(unsigned int, unsigned int)>& task) const {
+    const unsigned int nthreads = min(threads, n);
+    if(nthreads <= 1) {
+        for(unsigned int i = 0; i < n; i++) {
+            task(i, 0);
+        }
+        return;
+    }
+
+    vector<TaskRange> ranges(nthreads);
+    for(unsigned int t = 0; t < nthreads; t++) {
+        ranges[t].front = (unsigned long long) n*t/nthreads;
+        ranges[t].back = (unsigned long long) n*(t + 1)/nthreads;
+    }
+
+    atomic<bool> failed(false);
+    vector<exception_ptr> errors(nthreads);
+    auto worker = [&](unsigned int t) {
+        try {
+            unsigned int i;
+            while(!failed.load(memory_order_relaxed)) {
+                if(ranges[t].Pop(i)) task(i, t);
+                else if(!Steal(ranges, t)) break;
+            }
+        }
+        catch(...) {
+            errors[t] = current_exception();
+            failed = true;
+        }
+    };
+
+    vector<thread> workers;
+    for(unsigned int t = 1; t < nthreads; t++) {
+        workers.push_back(thread(worker, t));
+    }
+    worker(0);
+    for(unsigned int t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    for(unsigned int t = 0; t < errors.size(); t++) {
+        if(errors[t]) rethrow_exception(errors[t]);
+    }
+}
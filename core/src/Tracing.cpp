@@ -0,0 +1,200 @@
+#include "Tracing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdio.h>
+
+using namespace std;
+
+std::atomic<bool> Tracing::enabled(false);
+
+namespace {
+    const chrono::steady_clock::time_point epoch = chrono::steady_clock::now();
+    atomic<unsigned int> capacity(65536);
+    //finished threads' events are kept in a shared ring this many times a thread's
+    const unsigned int retired_threads = 16;
+
+    //a ring of the latest limit events
+    class Ring {
+      public:
+        vector<Tracing::Event> events;
+        size_t next, limit;
+
+        Ring() : next(0), limit(0) {}
+        void Add(const Tracing::Event& event, size_t l) {
+            if(l != limit) Clear(l);
+            if(limit == 0) return;
+            if(events.size() < limit) events.push_back(event);
+            else events[next % limit] = event;
+            next++;
+        }
+        void Clear(size_t l) {
+            events.clear();
+            next = 0;
+            limit = l;
+        }
+    };
+
+    class ThreadBuffer {
+      public:
+        mutex lock;
+        Ring ring;
+        unsigned int thread;
+
+        ThreadBuffer();
+        ~ThreadBuffer();
+    };
+
+    //the running threads' buffers, which rows are taken, and what the finished threads recorded
+    mutex registry_mutex;
+    vector<ThreadBuffer*> registry;
+    vector<bool> rows;
+    Ring retired;
+
+    mutex intern_mutex;
+    set<string> interned;
+
+    ThreadBuffer::ThreadBuffer() {
+        lock_guard<mutex> guard(registry_mutex);
+        thread = find(rows.begin(), rows.end(), false) - rows.begin();
+        if(thread == rows.size()) rows.push_back(true);
+        else rows[thread] = true;
+        registry.push_back(this);
+    }
+
+    ThreadBuffer::~ThreadBuffer() {
+        lock_guard<mutex> guard(registry_mutex);
+        for(unsigned int e = 0; e < ring.events.size(); e++) {
+            retired.Add(ring.events[e], retired_threads*size_t(capacity.load()));
+        }
+        rows[thread] = false;
+        registry.erase(find(registry.begin(), registry.end(), this));
+    }
+
+    ThreadBuffer& Local() {
+        static thread_local ThreadBuffer buffer;
+        return buffer;
+    }
+
+    bool EarlierEvent(const Tracing::Event& a, const Tracing::Event& b) {
+        return a.start < b.start;
+    }
+
+    string JsonString(const char *s) {
+        string out = "\"";
+        for(; *s != 0; s++) {
+            if(*s == '"' || *s == '\\') out += '\\';
+            if((unsigned char) *s < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int) *s);
+                out += escaped;
+            }
+            else {
+                out += *s;
+            }
+        }
+        return out + "\"";
+    }
+};
+
+void Tracing::Enable(unsigned int events_per_thread) {
+    capacity = events_per_thread;
+    enabled = true;
+}
+
+void Tracing::Disable() {
+    enabled = false;
+}
+
+void Tracing::Clear() {
+    lock_guard<mutex> guard(registry_mutex);
+    retired.Clear(retired.limit);
+    for(unsigned int t = 0; t < registry.size(); t++) {
+        lock_guard<mutex> buffer_guard(registry[t]->lock);
+        registry[t]->ring.Clear(registry[t]->ring.limit);
+    }
+}
+
+const char* Tracing::Intern(const string& s) {
+    lock_guard<mutex> guard(intern_mutex);
+    return interned.insert(s).first->c_str();
+}
+
+uint64_t Tracing::Now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count();
+}
+
+void Tracing::Record(Event& event) {
+    ThreadBuffer& buffer = Local();
+    event.thread = buffer.thread;
+    lock_guard<mutex> guard(buffer.lock);
+    buffer.ring.Add(event, capacity.load(memory_order_relaxed));
+}
+
+vector<Tracing::Event> Tracing::Events() {
+    vector<Event> events;
+    {
+        lock_guard<mutex> guard(registry_mutex);
+        events = retired.events;
+        for(unsigned int t = 0; t < registry.size(); t++) {
+            lock_guard<mutex> buffer_guard(registry[t]->lock);
+            events.insert(events.end(), registry[t]->ring.events.begin(), registry[t]->ring.events.end());
+        }
+    }
+    stable_sort(events.begin(), events.end(), EarlierEvent);
+    return events;
+}
+
+string Tracing::ChromeTraceJson() {
+    const vector<Event> events = Events();
+    ostringstream out;
+    out.precision(15);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    unsigned int threads = 0;
+    for(unsigned int e = 0; e < events.size(); e++) threads = max(threads, events[e].thread + 1);
+    for(unsigned int t = 0; t < threads; t++) {
+        out << (t > 0 ? ",\n" : "\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t
+            << ", \"args\": {\"name\": \"thread " << t << "\"}}";
+    }
+    for(unsigned int e = 0; e < events.size(); e++) {
+        const Event& event = events[e];
+        //complete events, with times in microseconds
+        out << (e > 0 || threads > 0 ? ",\n" : "\n") << "{\"name\": " << JsonString(event.name) << ", \"cat\": "
+            << JsonString(event.category) << ", \"ph\": \"X\", \"ts\": " << 1e-3*double(event.start)
+            << ", \"dur\": " << 1e-3*double(event.duration) << ", \"pid\": 1, \"tid\": " << event.thread;
+        if(event.has_keyboard || event.has_fitness) {
+            out << ", \"args\": {";
+            if(event.has_keyboard) {
+                //as a string since it doesn't fit in a javascript number
+                char hash[32];
+                snprintf(hash, sizeof(hash), "\"%016llx\"", (unsigned long long) event.keyboard);
+                out << "\"keyboard\": " << hash;
+            }
+            if(event.has_fitness) {
+                out << (event.has_keyboard ? ", " : "") << "\"fitness\": ";
+                if(isfinite(event.fitness)) out << event.fitness;
+                else out << "null";
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+bool Tracing::Dump(const string& path) {
+    ofstream file(path.c_str());
+    file << ChromeTraceJson();
+    if(!file.good()) {
+        cerr << "ERROR: Unable to write " << path << "." << endl;
+        return false;
+    }
+    return true;
+}
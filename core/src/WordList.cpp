@@ -1,10 +1,76 @@
 #include "WordList.h"
 
 #include "RadixTree.h"
-
+#include "Hashing.h"
+#include "Instrumentation.h"
+#include "TaskScheduler.h"
+#include "Tracing.h"
+#include "PackedState.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string.h>
+#include <math.h>
+#include <thread>
 #include <utility>
+#include <sys/stat.h>
 using namespace std;
 
+namespace {
+    const char state_magic[8] = {'D', 'O', 'D', 'O', 'W', 'R', 'D', '\0'};
+    const uint32_t state_version = 1;
+
+    //files are split at whitespace into pieces of about this many bytes, which the threads share out
+    const size_t ingest_piece = 1 << 24;
+
+    class IngestPiece {
+      public:
+        const char *begin, *end;
+        IngestPiece(const char* b, const char* e) : begin(b), end(e) {}
+    };
+
+    //counts the cleaned tokens of [begin, end), returning how many there were
+    unsigned int CountTokens(const char* begin, const char* end, const TokenCleaner& cleaner,
+            boost::unordered_map<string, unsigned int>& counts) {
+        unsigned int tokens = 0;
+        string token;
+        while(cleaner.Next(begin, end, token)) {
+            counts[token]++;
+            tokens++;
+        }
+        return tokens;
+    }
+
+    typedef pair<const string*, unsigned int> WordCount;
+
+    bool AlphabeticalOrder(const WordCount& a, const WordCount& b) {
+        return *a.first < *b.first;
+    }
+
+    //most common first, ties in alphabetical order
+    bool CountOrder(const WordCount& a, const WordCount& b) {
+        return a.second > b.second || (a.second == b.second && *a.first < *b.first);
+    }
+
+    bool MergedCountOrder(const pair<string, unsigned int>& a, const pair<string, unsigned int>& b) {
+        return a.second > b.second;
+    }
+
+    //the next word of every list on a min-heap, so the front is the alphabetically first
+    class MergeCursor {
+      public:
+        const vector<WordCount> *entries;
+        unsigned int position;
+        MergeCursor(const vector<WordCount>* e) : entries(e), position(0) {}
+        const string& Word() const { return *(*entries)[position].first; }
+        bool operator<(const MergeCursor& other) const { return other.Word() < Word(); }
+    };
+};
+
 WordList::WordList() {
     tree = new RadixTree();
     Reset();
@@ -29,6 +95,9 @@ WordList& WordList::operator=(const WordList& wl) {
     distribution = wl.distribution;
     distribution_current = wl.distribution_current;
     letters_current = wl.letters_current;
+    vector_current = wl.vector_current;
+    fingerprint = wl.fingerprint;
+    fingerprint_current = wl.fingerprint_current;
 
     occurance_vector = wl.occurance_vector;
     word_vector = wl.word_vector;
@@ -81,6 +150,63 @@ unsigned int WordList::AddWord(const char *word, const unsigned int occurances)
     return occurances;
 }
 
+unsigned int WordList::IngestFiles(const vector<string>& paths, const IngestOptions& options) {
+    const TokenCleaner cleaner(options);
+
+    vector<boost::iostreams::mapped_file_source> files;
+    vector<IngestPiece> pieces;
+    for(unsigned int f = 0; f < paths.size(); f++) {
+        struct stat info;
+        if(stat(paths[f].c_str(), &info) != 0) {
+            cerr << "ERROR: Unable to read " << paths[f] << "." << endl;
+            continue;
+        }
+        //empty files can't be mapped
+        if(info.st_size == 0) continue;
+        try {
+            files.push_back(boost::iostreams::mapped_file_source(paths[f]));
+        }
+        catch(exception& e) {
+            cerr << "ERROR: Unable to map " << paths[f] << ": " << e.what() << endl;
+            continue;
+        }
+        const char *begin = files.back().data(), *end = begin + files.back().size();
+        while(begin < end) {
+            const char *split = begin + min((size_t) (end - begin), ingest_piece);
+            while(split < end && !TokenCleaner::IsSeparator(*split)) split++;
+            pieces.push_back(IngestPiece(begin, split));
+            begin = split;
+        }
+    }
+
+    unsigned int nthreads = options.threads > 0 ? options.threads : thread::hardware_concurrency();
+    nthreads = min(max(nthreads, 1u), (unsigned int) max(pieces.size(), (size_t) 1));
+
+    //every thread counts into its own map and they're merged afterwards
+    vector<wordmap> counts(nthreads);
+    vector<unsigned int> tokens(nthreads, 0);
+    TaskScheduler(nthreads).Run(pieces.size(), [&](unsigned int p, unsigned int t) {
+        tokens[t] += CountTokens(pieces[p].begin, pieces[p].end, cleaner, counts[t]);
+    });
+
+    unsigned int added = 0;
+    for(unsigned int t = 0; t < nthreads; t++) {
+        if(t == 0 && words.size() == 0 && total == 0) {
+            //nothing to merge into so the first map can be taken as it is
+            words.swap(counts[0]);
+            total = tokens[0];
+            MarkNotCurrent();
+        }
+        else {
+            for(wordmap::iterator it = counts[t].begin(); it != counts[t].end(); it++) {
+                AddWord(it->first.c_str(), it->second);
+            }
+        }
+        added += tokens[t];
+    }
+    return added;
+}
+
 unsigned int WordList::Occurances(const char *word) {
     const wordmap::iterator it = words.find(string(word));
     if(it != words.end()) {
@@ -89,6 +215,11 @@ unsigned int WordList::Occurances(const char *word) {
     return 0;
 }
 
+const char* WordList::Find(const char *word) const {
+    const wordmap::const_iterator it = words.find(string(word));
+    return it != words.end() ? it->first.c_str() : 0;
+}
+
 unsigned int WordList::Words() {
     UpdateVectors();
     return words.size();
@@ -134,6 +265,12 @@ const char* WordList::RandomWord() {
     return word_vector[distribution(generator)].c_str();
 }
 
+const char* WordList::RandomWord(boost::mt19937& g) {
+    UpdateVectors();
+    UpdateDistribution();
+    return word_vector[distribution(g)].c_str();
+}
+
 int WordList::WordIndex(const char* word) {
     unsigned int idx = 0;
     for(std::vector<std::string> ::iterator it = word_vector.begin(); it != word_vector.end(); it++) {
@@ -145,8 +282,9 @@ int WordList::WordIndex(const char* word) {
     return -1;
 }
 
+//most common first, and alphabetical among words as common as each other, like CountOrder
 bool sortcomparison(const pair<string, unsigned int> &a, const pair<string, unsigned int> &b ) { 
-    return (a.second > b.second); 
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
 }
 
 void WordList::MarkNotCurrent() {
@@ -154,6 +292,7 @@ void WordList::MarkNotCurrent() {
     distribution_current = false;
     letters_current = false;
     tree_current = false;
+    fingerprint_current = false;
 }
 
 void WordList::UpdateLetters() {
@@ -183,6 +322,8 @@ void WordList::UpdateLetters() {
 
 void WordList::UpdateVectors() {
     if(!vector_current) {
+        DODONA_TIME(UpdateVectors);
+        Tracing::Span span("UpdateVectors", "wordlist");
         word_vector.clear();
         occurance_vector.clear();
         for(unsigned int i = 0; i < MAXN; i++) {
@@ -209,13 +350,13 @@ void WordList::UpdateVectors() {
         sorted.clear();
 
         vector_current = true;
+        distribution_current = false;
     }
-
-    distribution_current = false;
 }
 
 void WordList::UpdateDistribution() {
     if(!distribution_current) {
+        Tracing::Span span("UpdateDistribution", "wordlist");
         distribution = boost::random::discrete_distribution<>(occurance_vector);
     }
     distribution_current = true;
@@ -223,6 +364,8 @@ void WordList::UpdateDistribution() {
 
 void WordList::UpdateTree() {
     if(tree_current == false) {
+        DODONA_TIME(UpdateTree);
+        Tracing::Span span("UpdateTree", "wordlist");
         tree->Reset();
         for(unsigned int i = 0; i < Words(); i++) {
             tree->AddWord(Word(i));
@@ -231,6 +374,51 @@ void WordList::UpdateTree() {
     tree_current = true;
 }
 
+string WordList::PackWords() const {
+    string packed;
+    for(unsigned int i = 0; i < word_vector.size(); i++) {
+        packed += word_vector[i];
+        packed += '\0';
+    }
+    return packed;
+}
+
+void WordList::UnpackWords(const string& packed) {
+    word_vector.clear();
+    word_vector.reserve(occurance_vector.size());
+    for(size_t start = 0; start < packed.size(); ) {
+        const size_t end = packed.find('\0', start);
+        word_vector.push_back(string(packed.data() + start, end - start));
+        start = end + 1;
+    }
+}
+
+void WordList::RebuildFromVectors() {
+    words.clear();
+    words.reserve(word_vector.size());
+    total = 0;
+    for(unsigned int i = 0; i < MAXN; i++) {
+        Nword_vector[i].clear();
+        Noccurance_vector[i].clear();
+    }
+    for(unsigned int i = 0; i < word_vector.size(); i++) {
+        words.insert(make_pair(word_vector[i], occurance_vector[i]));
+        total += occurance_vector[i];
+        const unsigned int l = word_vector[i].length();
+        if(l > 0 && l <= MAXN) {
+            Nword_vector[l-1].push_back(word_vector[i]);
+            Noccurance_vector[l-1].push_back(occurance_vector[i]);
+        }
+    }
+
+    //the vectors were saved sorted so they stay as they are, which also keeps the order of tied words
+    vector_current = true;
+    distribution_current = false;
+    letters_current = false;
+    tree_current = false;
+    fingerprint_current = false;
+}
+
 void WordList::UpdateAll() {
     UpdateVectors();
     UpdateDistribution();
@@ -238,6 +426,10 @@ void WordList::UpdateAll() {
     UpdateTree();
 }
 
+void WordList::Prepare() {
+    UpdateAll();
+}
+
 
 unsigned int WordList::TotalLetterOccurances() { 
     UpdateLetters();
@@ -253,15 +445,184 @@ unsigned int WordList::LetterOccurances(const char c) {
     return 0;
 }
 
-WordList WordList::operator+(const WordList& other) {    
-    WordList w = WordList(other);
-    for(wordmap::iterator it = words.begin(); it != words.end(); it++) {
-        w.AddWord((it->first).c_str(), it->second);
+WordList WordList::operator+(const WordList& other) {
+    vector<const WordList*> lists;
+    lists.push_back(&other);
+    lists.push_back(this);
+    WordList w = Merge(lists, 1);
+    w.generator = other.generator;
+    return w;
+}
+
+WordList WordList::Merge(const vector<const WordList*>& lists, unsigned int threads) {
+    //every list's words sorted alphabetically, by pointer into its own map, sorting several lists at once
+    vector< vector<WordCount> > sorted(lists.size());
+    unsigned int nthreads = threads > 0 ? threads : thread::hardware_concurrency();
+    nthreads = min(max(nthreads, 1u), (unsigned int) max(lists.size(), (size_t) 1));
+    TaskScheduler(nthreads).Run(lists.size(), [&](unsigned int l, unsigned int) {
+        sorted[l].reserve(lists[l]->words.size());
+        for(wordmap::const_iterator it = lists[l]->words.begin(); it != lists[l]->words.end(); it++) {
+            sorted[l].push_back(WordCount(&it->first, it->second));
+        }
+        sort(sorted[l].begin(), sorted[l].end(), AlphabeticalOrder);
+    });
+
+    //k-way merge, summing each word's occurances across the lists
+    vector<MergeCursor> heap;
+    size_t most = 0;
+    for(unsigned int l = 0; l < sorted.size(); l++) {
+        if(sorted[l].size() > 0) heap.push_back(MergeCursor(&sorted[l]));
+        most += sorted[l].size();
     }
-    
+    make_heap(heap.begin(), heap.end());
+    vector< pair<string, unsigned int> > merged;
+    merged.reserve(most);
+    while(heap.size() > 0) {
+        pop_heap(heap.begin(), heap.end());
+        MergeCursor& c = heap.back();
+        const WordCount& entry = (*c.entries)[c.position];
+        if(merged.size() > 0 && merged.back().first == *entry.first) {
+            merged.back().second += entry.second;
+        }
+        else {
+            merged.push_back(make_pair(*entry.first, entry.second));
+        }
+        if(++c.position < c.entries->size()) {
+            push_heap(heap.begin(), heap.end());
+        }
+        else {
+            heap.pop_back();
+        }
+    }
+
+    //stable so that tied words stay in alphabetical order
+    stable_sort(merged.begin(), merged.end(), MergedCountOrder);
+    WordList w;
+    w.BuildFromSorted(merged);
+    return w;
+}
+
+WordList WordList::TopN(unsigned int N) const {
+    vector< pair<string, unsigned int> > top;
+    if(vector_current) {
+        //the sorted vectors are already there, in the same order the partial sort would give
+        N = min(N, (unsigned int) word_vector.size());
+        top.reserve(N);
+        for(unsigned int i = 0; i < N; i++) {
+            top.push_back(make_pair(word_vector[i], occurance_vector[i]));
+        }
+    }
+    else {
+        vector<WordCount> entries;
+        entries.reserve(words.size());
+        for(wordmap::const_iterator it = words.begin(); it != words.end(); it++) {
+            entries.push_back(WordCount(&it->first, it->second));
+        }
+        N = min(N, (unsigned int) entries.size());
+        partial_sort(entries.begin(), entries.begin() + N, entries.end(), CountOrder);
+        top.reserve(N);
+        for(unsigned int i = 0; i < N; i++) {
+            top.push_back(make_pair(*entries[i].first, entries[i].second));
+        }
+    }
+    WordList w;
+    w.BuildFromSorted(top);
     return w;
 }
 
+WordList WordList::Zipfian(unsigned int words, double exponent, unsigned int seed, unsigned int top_occurances) {
+    //percentages of the letters a to z in english text, and of english words with 1 to 12 letters
+    const double letter_weights[26] = {8.2, 1.5, 2.8, 4.3, 12.7, 2.2, 2.0, 6.1, 7.0, 0.15, 0.77, 4.0, 2.4, 6.7, 7.5,
+        1.9, 0.095, 6.0, 6.3, 9.1, 2.8, 0.98, 2.4, 0.15, 2.0, 0.074};
+    const double length_weights[12] = {1, 4, 10, 15, 17, 16, 14, 11, 8, 5, 3, 2};
+    boost::mt19937 g(seed);
+    boost::random::discrete_distribution<> letter(letter_weights, letter_weights + 26);
+    boost::random::discrete_distribution<> length(length_weights, length_weights + 12);
+
+    boost::unordered_set<string> seen;
+    vector< pair<string, unsigned int> > sorted;
+    sorted.reserve(words);
+    string word;
+    while(sorted.size() < words) {
+        word.resize(length(g) + 1);
+        for(unsigned int i = 0; i < word.size(); i++) word[i] = 'a' + letter(g);
+        if(!seen.insert(word).second) continue;
+        const double occurances = double(top_occurances)/pow(double(sorted.size() + 1), exponent);
+        sorted.push_back(make_pair(word, max(1u, (unsigned int) (occurances + 0.5))));
+    }
+    //the rarer words round to the same counts, which go in the same order UpdateVectors gives them
+    sort(sorted.begin(), sorted.end(), sortcomparison);
+
+    WordList w;
+    w.BuildFromSorted(sorted);
+    w.generator.seed(seed);
+    return w;
+}
+
+void WordList::BuildFromSorted(vector< pair<string, unsigned int> >& sorted) {
+    Reset();
+    word_vector.resize(sorted.size());
+    occurance_vector.resize(sorted.size());
+    for(unsigned int i = 0; i < sorted.size(); i++) {
+        word_vector[i].swap(sorted[i].first);
+        occurance_vector[i] = sorted[i].second;
+    }
+    RebuildFromVectors();
+}
+
+string WordList::PackState() {
+    UpdateVectors();
+    const string packed = PackWords();
+    StateWriter state(state_magic, state_version);
+    state.Reserve(12 + 4*occurance_vector.size() + packed.size());
+    state.PutU32(occurance_vector.size());
+    for(unsigned int i = 0; i < occurance_vector.size(); i++) {
+        state.PutU32(occurance_vector[i]);
+    }
+    state.PutString(packed);
+    return state.State();
+}
+
+bool WordList::UnpackState(const char* data, size_t size) {
+    StateReader state(data, size, state_magic, state_version);
+    uint32_t nwords = 0;
+    if(!state.GetU32(nwords) || !state.Fits(nwords, 4)) {
+        return false;
+    }
+    vector<unsigned int> occurances(nwords);
+    for(unsigned int i = 0; i < nwords; i++) {
+        uint32_t o = 0;
+        state.GetU32(o);
+        occurances[i] = o;
+    }
+    const char *block = 0;
+    size_t length = 0;
+    if(!state.GetBytes(block, length) || !state.Finished()) {
+        return false;
+    }
+    //every word is nul terminated, so the block has to end in one and hold exactly nwords of them
+    if((length > 0 && block[length - 1] != '\0') || (uint64_t) count(block, block + length, '\0') != nwords) {
+        return false;
+    }
+
+    occurance_vector.swap(occurances);
+    UnpackWords(string(block, length));
+    RebuildFromVectors();
+    return true;
+}
+
+//kept until the words next change, since the models check it on every BestMatch
+uint64_t WordList::Fingerprint() {
+    if(!fingerprint_current) {
+        fingerprint = HashMix(words.size());
+        for(wordmap::iterator it = words.begin(); it != words.end(); it++) {
+            fingerprint += HashCombine(HashString(it->first.c_str()), it->second);
+        }
+        fingerprint_current = true;
+    }
+    return fingerprint;
+}
+
 void WordList::Reset() {
     //clear up all memory
     occurance_vector.clear();
@@ -0,0 +1,24 @@
+#include "WorkerModels.h"
+
+using namespace std;
+
+WorkerModels::WorkerModels(InputModel& model, unsigned int threads) {
+    shared = threads > 1 && model.Shareable() ? &model : 0;
+    for(unsigned int i = 0; i < threads && threads > 1 && shared == 0; i++) {
+        InputModel *clone = model.Clone();
+        if(clone == 0) {
+            break;
+        }
+        clones.push_back(clone);
+        if(clone->Shareable()) {
+            shared = clone;
+        }
+    }
+    workers = shared != 0 ? threads : clones.size();
+}
+
+WorkerModels::~WorkerModels() {
+    for(unsigned int i = 0; i < clones.size(); i++) {
+        delete clones[i];
+    }
+}
@@ -3,6 +3,7 @@
 from dodona import core, keyboards
 
 from random import random
+import functools
 import numpy as np
 import multiprocessing as mp
 
@@ -17,11 +18,25 @@ def thread(inList, func):
     return outList
 
 
+#records one span per generation when tracing is on, see core.EnableTracing, carrying the best fitness
+def TracedGeneration(evolve):
+    @functools.wraps(evolve)
+    def traced(*args, **kwargs):
+        with core.TraceSpan('generation', 'optimization') as span:
+            newkList = evolve(*args, **kwargs)
+            if len(newkList) > 0:
+                span.SetFitness(max([ f.Fitness() for k, f in newkList ]))
+            return newkList
+    return traced
+
 #Takes a generation (current list of keyboards) and evolves a new generation based on a genetic-ish algorithm
 #kList is the current generation (list) of keyboards paired with their fitness, and inputModel is the inputModel to be used in the fitness function
+#batchFitness can be given instead of fitness to score the whole generation in one call, e.g.
+#   lambda keyboards: core.EvaluateKeyboards(keyboards, model, wordlist, options)
 #returns newkList which is the new generation (list) of keyboards
 
-def Evolve(kList, fitness, pressurePoint = 0, mutationRate = 0.2):
+@TracedGeneration
+def Evolve(kList, fitness, pressurePoint = 0, mutationRate = 0.2, batchFitness = None):
     nk = len(kList)
     fitnessResultList = [ kList[i][1] for i in range(len(kList))  ]
 
@@ -58,13 +73,15 @@ def Evolve(kList, fitness, pressurePoint = 0, mutationRate = 0.2):
         if np.random.rand() < mutationRate:
             newKeyboardB = keyboards.RandomSwap(newKeyboardB,1)
 
-        newFitnessA = fitness(newKeyboardA)
-        newFitnessB = fitness(newKeyboardB)
+        newkList.append(newKeyboardA)
+        newkList.append(newKeyboardB)
 
-        newkList.append((newKeyboardA,newFitnessA))
-        newkList.append((newKeyboardB,newFitnessB))
+    if batchFitness != None:
+        newFitnessList = batchFitness(newkList)
+    else:
+        newFitnessList = [ fitness(k) for k in newkList ]
 
-    return newkList
+    return list(zip(newkList, newFitnessList))
 
 
 
@@ -0,0 +1,78 @@
+import mmap
+import struct
+
+import numpy as np
+
+MAGIC = b"DODOCOL\0"
+
+def _ReadString(header, position):
+    length, = struct.unpack_from("=I", header, position)
+    position += 4
+    return header[position:position+length], position + length
+
+def LoadColumns(filename):
+    """Memory maps a file written by ResultsTable.Save and returns (metadata, columns).  The columns are
+    read only numpy arrays backed by the file: layouts (layouts x characters polygon indices), and
+    layout, efficiency, fitness, error and iterations with one entry per result."""
+    with open(filename, "rb") as f:
+        data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    if data[:8] != MAGIC:
+        raise ValueError(filename + " is not a results table.")
+    version, length = struct.unpack_from("=II", data, 8)
+    if version != 1:
+        raise ValueError(filename + " was written by an unsupported version.")
+    header = data[16:16+length]
+
+    metadata = {}
+    position = 0
+    for key in ("wordlistname", "inputmodel", "distancemeasure", "characters"):
+        value, position = _ReadString(header, position)
+        metadata[key] = value.decode("latin-1")
+    count, = struct.unpack_from("=I", header, position)
+    position += 4
+    types = []
+    for i in range(count):
+        value, position = _ReadString(header, position)
+        types.append(value.decode("utf-8", errors="replace"))
+    metadata["efficiencytypes"] = types
+    count, = struct.unpack_from("=I", header, position)
+    position += 4
+    polygons = []
+    for i in range(count):
+        vertices, = struct.unpack_from("=I", header, position)
+        position += 4
+        polygons.append(np.frombuffer(header, "=f8", 2*vertices, position).reshape(vertices, 2))
+        position += 16*vertices
+    metadata["polygons"] = polygons
+
+    columns = {}
+    count, = struct.unpack_from("=I", header, position)
+    position += 4
+    for i in range(count):
+        name, position = _ReadString(header, position)
+        dtype, position = _ReadString(header, position)
+        ndim, = struct.unpack_from("=I", header, position)
+        shape = struct.unpack_from("=%dQ" % ndim, header, position + 4)
+        offset, = struct.unpack_from("=Q", header, position + 4 + 8*ndim)
+        position += 12 + 8*ndim
+        items = int(np.prod(shape))
+        columns[name.decode()] = np.frombuffer(data, dtype.decode(), items, offset).reshape(shape)
+    return metadata, columns
+
+def LoadResults(filename):
+    """The results of a file written by ResultsTable.Save as a numpy structured array with one record
+    per result, plus the metadata and layouts array returned by LoadColumns."""
+    metadata, columns = LoadColumns(filename)
+    names = ["layout", "efficiency", "fitness", "error", "iterations"]
+    results = np.rec.fromarrays([columns[n] for n in names], names=names)
+    return results, metadata, columns["layouts"]
+
+def BestLayouts(filename, efficiency, N=1, highest=False):
+    """Indices into the layouts array of the N results with the lowest (or highest) fitness of one
+    efficiency type, best first, and their fitnesses."""
+    metadata, columns = LoadColumns(filename)
+    type_index = metadata["efficiencytypes"].index(efficiency)
+    rows = np.flatnonzero(columns["efficiency"] == type_index)
+    fitness = columns["fitness"][rows]
+    order = np.argsort(-fitness if highest else fitness, kind="stable")[:N]
+    return columns["layout"][rows[order]], fitness[order]
@@ -14,8 +14,21 @@ def ReadBook(book, wordlist=None, cleaner=AlphaOnly):
                     wordlist.AddWord(word)
     return wordlist
 
+#the native, multi-threaded reader.  Its default options clean like AlphaOnly except that only ascii
+#letters count as letters, so accented ones are dropped rather than kept.
+def ReadBooks(books, wordlist=None, options=None):
+    if wordlist == None:
+        wordlist = core.WordList()
+    if options == None:
+        options = core.IngestOptions()
+    #raise like ReadBook would rather than leave the native reader to skip the file
+    for book in books:
+        open(book, "rb").close()
+    wordlist.IngestFiles(books, options)
+    return wordlist
+
 def MostCommon(wordlist, N):
-    w2 = core.WordList()
-    for i in range(min(N,wordlist.Words())):
-        w2.AddWord(wordlist.Word(i), wordlist.Occurances(i))
-    return w2
+    return wordlist.TopN(N)
+
+def Combine(wordlists):
+    return core.MergeWordLists(wordlists)